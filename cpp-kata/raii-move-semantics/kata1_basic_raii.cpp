@@ -8,100 +8,2541 @@
  */
 
 #include <iostream> // For console output
-#include <fstream> // For file operations
+#include <ios> // For std::ios::openmode
 #include <string> // For string operations
-#include <stdexcept> // For exception handling
+#include <stdexcept> // For exception handling and std::out_of_range
+#include <string_view> // For non-owning views over mapped pages
+#include <span> // For caller-owned read buffers
+#include <array> // For fixed-size buffers
+#include <vector> // For chunk buffers
+#include <thread> // For background read-ahead
+#include <mutex> // For std::mutex
+#include <condition_variable> // For handing chunks between threads
+#include <exception> // For std::exception_ptr
+#include <iterator> // For std::default_sentinel_t and std::prev/std::next
+#include <cstddef> // For std::ptrdiff_t
+#include <sstream> // For the std::getline benchmark baseline
+#include <utility> // For std::pair
+#include <optional> // For the optional write buffer
+#include <initializer_list> // For vectored I/O buffer lists
+#include <future> // For durability notifications from AppendLog
+#include <atomic> // For AppendLog statistics and io_uring ring indices
+#include <functional> // For async completion callbacks
+#include <deque> // For the I/O thread-pool queue
+#include <memory> // For engine ownership and shared in-flight counters
+#include <new> // For std::align_val_t
+#include <random> // For random-offset benchmarks
+#include <climits> // For UINT32_MAX
+#include <list> // For the FileHandleCache LRU order
+#include <unordered_map> // For FileHandleCache lookups
+#include <charconv> // For std::from_chars in the replay benchmark
+#include <cmath> // For std::abs
+#include <cstring> // For std::strerror
+#include <cerrno> // For errno
+#include <cstdint> // For fixed-width integer types
+#include <chrono> // For benchmark timing
+#include <algorithm> // For std::min
+#include <cstdio> // For std::remove
+#include <fcntl.h> // For open(2) flags
+#include <unistd.h> // For read(2)/write(2)/close(2)
+#include <sys/mman.h> // For mmap/munmap/madvise/msync
+#include <sys/stat.h> // For fstat(2)
+#include <sys/uio.h> // For readv(2)/writev(2)
+#include <sys/sendfile.h> // For sendfile(2)
+#include <sys/resource.h> // For peak RSS in benchmarks
+#include <sys/wait.h> // For wait4(2) in benchmarks
+#include <sys/syscall.h> // For the raw io_uring syscalls
+#include <linux/io_uring.h> // For io_uring ring layout and opcodes
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h> // For SSE2/AVX2 newline search
+#endif
 
-// TODO: Implement the FileHandle class
-class FileHandle {
+// Access-pattern hints forwarded to madvise(2) for a mapped file
+enum class MapAdvice {
+    Normal,     // MADV_NORMAL: default kernel read-ahead
+    Sequential, // MADV_SEQUENTIAL: aggressive read-ahead, pages dropped behind the reader
+    Random,     // MADV_RANDOM: no read-ahead
+    WillNeed    // MADV_WILLNEED: start paging the whole range in now
+};
+
+// Whether a mapping may be written through (MAP_SHARED writes land in the file)
+enum class MapMode {
+    ReadOnly,
+    ReadWrite
+};
+
+// RAII owner of an mmap'd file region: the pages are unmapped in the destructor.
+// Move-only for the same reason FileHandle is - two owners would munmap twice.
+class MappedRegion {
 private:
-    std::fstream file_; // File stream for managing file operations
-    std::string filename_; // Store the filename for reference
-    bool is_open_; // Track if the file is open
+    char* data_; // Start of the mapping (nullptr when empty)
+    std::size_t size_; // Length of the mapping in bytes
+    std::string filename_; // Store the filename for error messages
+
+    void unmap() noexcept {
+        if (data_) {
+            ::munmap(data_, size_); // Release the pages
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
 
 public:
-    // TODO: Constructor should open the file and handle errors
-    explicit FileHandle(const std::string& filename, std::ios::openmode mode = std::ios::in | std::ios::out) { // explicit is used to prevent implicit conversions
-        // Your implementation here
-        filename_ = filename; // Store the filename for reference 
-        file_.open(filename,mode); // Check if the file opened successfully
-        if (!file_.is_open()) {
-            throw std::runtime_error("Failed to open file: " + filename);
+    MappedRegion() noexcept : data_(nullptr), size_(0) {}
+
+    MappedRegion(char* data, std::size_t size, std::string filename) noexcept
+        : data_(data), size_(size), filename_(std::move(filename)) {}
+
+    ~MappedRegion() {
+        unmap(); // RAII: pages go away with the owner
+    }
+
+    MappedRegion(const MappedRegion&) = delete; // Disable copy constructor
+    MappedRegion& operator=(const MappedRegion&) = delete; // Disable copy assignment
+
+    MappedRegion(MappedRegion&& other) noexcept
+        : data_(other.data_), size_(other.size_), filename_(std::move(other.filename_)) {
+        other.data_ = nullptr; // Leave 'other' in a valid but empty state
+        other.size_ = 0;
+    }
+
+    MappedRegion& operator=(MappedRegion&& other) noexcept {
+        if (this != &other) {
+            unmap(); // Drop our current pages first
+            data_ = other.data_;
+            size_ = other.size_;
+            filename_ = std::move(other.filename_);
+            other.data_ = nullptr;
+            other.size_ = 0;
         }
-        is_open_ = true; // Set the file as open
+        return *this;
     }
 
-    
-    // TODO: Destructor should automatically close the file
-    ~FileHandle() {
-        if (!is_open_) {
-            return; // If the file is not open, nothing to close
+    // Read-only view over the mapped bytes - no copy
+    std::string_view view() const noexcept {
+        return std::string_view(data_, size_);
+    }
+
+    char* data() noexcept { return data_; } // Writable only for MapMode::ReadWrite
+    const char* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    // Pass an access-pattern hint to the kernel for the whole mapping
+    void advise(MapAdvice advice) {
+        if (!data_) {
+            return; // Nothing mapped (empty file)
+        }
+        int native = MADV_NORMAL;
+        switch (advice) {
+            case MapAdvice::Normal: native = MADV_NORMAL; break;
+            case MapAdvice::Sequential: native = MADV_SEQUENTIAL; break;
+            case MapAdvice::Random: native = MADV_RANDOM; break;
+            case MapAdvice::WillNeed: native = MADV_WILLNEED; break;
+        }
+        if (::madvise(data_, size_, native) != 0) {
+            throw std::runtime_error("Failed to advise mapping of file: " + filename_ + ": " + std::strerror(errno));
         }
-        file_.close(); // Close the file
-        is_open_ = false; // Mark the file as closed
-        std::cout << "File '" << filename_ << "' closed automatically.\n";
-        
-        // Your implementation here
     }
-    
-    // TODO: Disable copy constructor and copy assignment (Rule of 5)
-    FileHandle(const FileHandle&) = delete; // Disable copy constructor
-    FileHandle& operator=(const FileHandle&) = delete; // Disable copy assignment
-    
-    // TODO: Implement move constructor and move assignment
-    FileHandle(FileHandle&& other) noexcept {
-        file_ = std::move(other.file_); // Transfer ownership of the file stream
-        filename_ = std::move(other.filename_); // Transfer ownership of the filename
-        is_open_ = other.is_open_; // Transfer the open state
-        other.is_open_ = false; // Leave 'other' in a valid but empty state
-        std::cout << "FileHandle moved from '" << other.filename_ << "' to '" << filename_ << "'\n";
-        other.filename_.clear(); // Clear the filename of the moved-from object
+
+    // Write dirty pages of a ReadWrite mapping back to the file
+    void sync() {
+        if (data_ && ::msync(data_, size_, MS_SYNC) != 0) {
+            throw std::runtime_error("Failed to sync mapping of file: " + filename_ + ": " + std::strerror(errno));
+        }
     }
-    
-    FileHandle& operator=(FileHandle&& other) noexcept {
-        if (this != &other) { // Self-assignment check? whats this? this is a this pointer that points to the current object
-            // If the current file is open, close it first
-            if (is_open_) {
-                file_.close(); // Close the current file if open
+};
+
+// Translate iostream open modes to open(2) flags, following the std::fopen table
+// that std::fstream uses ("r", "w", "a", "r+", "w+", "a+")
+inline int to_open_flags(std::ios::openmode mode) {
+    const bool in = (mode & std::ios::in) == std::ios::in;
+    const bool out = (mode & std::ios::out) == std::ios::out;
+    const bool app = (mode & std::ios::app) == std::ios::app;
+    const bool trunc = (mode & std::ios::trunc) == std::ios::trunc;
+
+    int flags = O_CLOEXEC;
+    if (app) {
+        flags |= (in ? O_RDWR : O_WRONLY) | O_CREAT | O_APPEND; // "a" / "a+"
+    } else if (out && in) {
+        flags |= O_RDWR | (trunc ? O_CREAT | O_TRUNC : 0); // "r+" / "w+"
+    } else if (out) {
+        flags |= O_WRONLY | O_CREAT | O_TRUNC; // "w"
+    } else {
+        flags |= O_RDONLY; // "r"
+    }
+    return flags;
+}
+
+// Newline search kernels: return the first '\n' in [first, last), or last if there is none.
+// The SSE2/AVX2 versions compare 16/32 bytes per step; newline_finder() picks the widest
+// one the running CPU supports, with the scalar loop as the portable fallback.
+using NewlineFinder = const char* (*)(const char* first, const char* last);
+
+inline const char* find_newline_scalar(const char* first, const char* last) {
+    while (first != last && *first != '\n') {
+        ++first;
+    }
+    return first;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+inline const char* find_newline_sse2(const char* first, const char* last) {
+    const __m128i newline = _mm_set1_epi8('\n');
+    while (last - first >= 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        const auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline)));
+        if (mask != 0) {
+            return first + __builtin_ctz(mask); // Lowest set bit = first match
+        }
+        first += 16;
+    }
+    return find_newline_scalar(first, last); // Tail shorter than one vector
+}
+
+__attribute__((target("avx2"))) inline const char* find_newline_avx2(const char* first, const char* last) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    while (last - first >= 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newline)));
+        if (mask != 0) {
+            return first + __builtin_ctz(mask);
+        }
+        first += 32;
+    }
+    return find_newline_sse2(first, last);
+}
+#endif
+
+// Pick the newline kernel once, based on what the running CPU supports
+inline NewlineFinder newline_finder() {
+#if defined(__x86_64__) || defined(__i386__)
+    static const NewlineFinder finder = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return &find_newline_avx2;
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return &find_newline_sse2;
+        }
+        return &find_newline_scalar;
+    }();
+    return finder;
+#else
+    return &find_newline_scalar;
+#endif
+}
+
+// Non-owning range of the lines in a text buffer, yielded as string_views into it (no per-line
+// allocation). "\n" and "\r\n" both end a line, and a final line without a newline is still
+// yielded. The buffer must outlive the range.
+class LineRange {
+private:
+    std::string_view text_;
+    NewlineFinder finder_;
+
+public:
+    class iterator {
+    private:
+        const char* next_; // Start of the line after current_
+        const char* last_; // End of the buffer
+        NewlineFinder finder_;
+        std::string_view current_;
+        bool done_;
+
+        void load() {
+            if (next_ == last_) {
+                done_ = true; // No trailing empty line after a final newline
+                return;
             }
-            file_ = std::move(other.file_); // Transfer ownership of the file stream
-            filename_ = std::move(other.filename_); // Transfer ownership of the filename
-            is_open_ = other.is_open_; // Transfer the open state
-            other.is_open_ = false; // Leave 'other' in a valid but empty state
-            std::cout << "FileHandle moved from '" << other.filename_ << "' to '" << filename_ << "'\n";
-            other.filename_.clear(); // Clear the filename of the moved-from object
+            const char* newline = finder_(next_, last_);
+            std::size_t length = static_cast<std::size_t>(newline - next_);
+            if (length > 0 && next_[length - 1] == '\r') {
+                --length; // CRLF
+            }
+            current_ = std::string_view(next_, length);
+            next_ = newline == last_ ? last_ : newline + 1;
+        }
+
+    public:
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() noexcept : next_(nullptr), last_(nullptr), finder_(nullptr), done_(true) {}
+
+        iterator(std::string_view text, NewlineFinder finder)
+            : next_(text.data()), last_(text.data() + text.size()), finder_(finder), done_(false) {
+            load();
+        }
+
+        std::string_view operator*() const noexcept { return current_; }
+
+        iterator& operator++() {
+            load();
+            return *this;
+        }
+
+        void operator++(int) { load(); }
+
+        bool operator==(std::default_sentinel_t) const noexcept { return done_; }
+    };
+
+    explicit LineRange(std::string_view text, NewlineFinder finder = newline_finder()) noexcept
+        : text_(text), finder_(finder) {}
+
+    iterator begin() const { return iterator(text_, finder_); }
+    std::default_sentinel_t end() const noexcept { return {}; }
+};
+
+// Lines of a memory-mapped file: owns the mapping so the yielded string_views stay valid
+// for as long as this object lives.
+class MappedLines {
+private:
+    MappedRegion region_;
+
+public:
+    explicit MappedLines(MappedRegion region) noexcept : region_(std::move(region)) {}
+
+    LineRange::iterator begin() const { return LineRange(region_.view()).begin(); }
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+    const MappedRegion& region() const noexcept { return region_; }
+};
+
+// read(2) from 'fd' until 'size' bytes arrive or EOF; returns the number of bytes read
+inline std::size_t read_fd_fully(int fd, char* buffer, std::size_t size, const std::string& filename) {
+    std::size_t filled = 0;
+    while (filled < size) {
+        const ssize_t n = ::read(fd, buffer + filled, size - filled);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue; // Interrupted by a signal - retry
+            }
+            throw std::runtime_error("Failed to read from file: " + filename + ": " + std::strerror(errno));
+        }
+        if (n == 0) {
+            break; // EOF
+        }
+        filled += static_cast<std::size_t>(n);
+    }
+    return filled;
+}
+
+// Sequential reader over a borrowed descriptor that keeps exactly two chunks in memory:
+// a background thread reads the next chunk while the caller works on the current one.
+// Created by FileHandle::chunks(); destroying it (including breaking out of a range-for)
+// stops and joins the reader thread. The FileHandle must outlive it and must not be
+// read from while iteration is in progress.
+class ChunkReader {
+private:
+    int fd_; // Borrowed from the FileHandle - not closed here
+    std::string filename_; // Store the filename for error messages
+    std::array<std::vector<char>, 2> buffers_; // Double buffer: one being parsed, one being filled
+    std::array<std::size_t, 2> lengths_{}; // Valid bytes in each buffer (0 = EOF)
+    std::array<bool, 2> ready_{}; // Buffer holds a chunk the caller has not consumed yet
+    std::size_t current_ = 0; // Buffer the caller is looking at
+    bool started_ = false; // begin() has handed out the first chunk
+    bool done_ = false; // EOF reached or no chunks at all
+    bool stop_ = false; // Destructor asked the reader thread to quit
+    std::exception_ptr error_; // Failure raised on the reader thread, rethrown to the caller
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread reader_; // Declared last so every member above exists before it starts
+
+    void read_ahead() {
+        std::size_t slot = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [&] { return stop_ || !ready_[slot]; });
+                if (stop_) {
+                    return;
+                }
+            }
+            // Only this thread touches a buffer that is not ready, so read without the lock
+            std::size_t n = 0;
+            std::exception_ptr error;
+            try {
+                n = read_fd_fully(fd_, buffers_[slot].data(), buffers_[slot].size(), filename_);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                lengths_[slot] = n;
+                ready_[slot] = true;
+                error_ = error;
+            }
+            cv_.notify_all();
+            if (n == 0 || error) {
+                return; // EOF (published as an empty chunk) or failure
+            }
+            slot ^= 1;
+        }
+    }
+
+    // Block until the current slot is filled, then decide whether iteration is over
+    void wait_current() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] { return ready_[current_]; });
+        if (error_) {
+            done_ = true;
+            std::rethrow_exception(error_);
+        }
+        done_ = lengths_[current_] == 0;
+    }
+
+    // Hand the current buffer back to the reader thread and move to the other one
+    void advance() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ready_[current_] = false;
+        }
+        cv_.notify_all();
+        current_ ^= 1;
+        wait_current();
+    }
+
+public:
+    class iterator {
+    private:
+        ChunkReader* reader_;
+
+    public:
+        using value_type = std::span<const char>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() noexcept : reader_(nullptr) {}
+        explicit iterator(ChunkReader* reader) noexcept : reader_(reader) {}
+
+        std::span<const char> operator*() const {
+            return std::span<const char>(reader_->buffers_[reader_->current_].data(),
+                                         reader_->lengths_[reader_->current_]);
+        }
+
+        iterator& operator++() {
+            reader_->advance();
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        bool operator==(std::default_sentinel_t) const noexcept {
+            return !reader_ || reader_->done_;
+        }
+    };
+
+    ChunkReader(int fd, std::string filename, std::size_t chunk_size)
+        : fd_(fd), filename_(std::move(filename)),
+          buffers_{std::vector<char>(chunk_size), std::vector<char>(chunk_size)} {
+        if (chunk_size == 0) {
+            throw std::invalid_argument("Chunk size must be non-zero for file: " + filename_);
+        }
+        reader_ = std::thread(&ChunkReader::read_ahead, this);
+    }
+
+    ~ChunkReader() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true; // Early exit: the reader may be waiting for a free buffer
+        }
+        cv_.notify_all();
+        reader_.join();
+    }
+
+    // Pinned in place: the reader thread holds 'this'
+    ChunkReader(const ChunkReader&) = delete;
+    ChunkReader& operator=(const ChunkReader&) = delete;
+    ChunkReader(ChunkReader&&) = delete;
+    ChunkReader& operator=(ChunkReader&&) = delete;
+
+    // Single-pass: may be called once
+    iterator begin() {
+        if (started_) {
+            throw std::logic_error("ChunkReader is single-pass: " + filename_);
+        }
+        started_ = true;
+        wait_current();
+        return iterator(this);
+    }
+
+    std::default_sentinel_t end() const noexcept { return {}; }
+};
+
+// write(2) until every byte is accepted, retrying short writes; returns the number of write(2) calls
+inline std::size_t write_fd_fully(int fd, const char* data, std::size_t size, const std::string& filename) {
+    std::size_t written = 0;
+    std::size_t calls = 0;
+    while (written < size) {
+        const ssize_t n = ::write(fd, data + written, size - written);
+        ++calls;
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue; // Interrupted by a signal - retry
+            }
+            throw std::runtime_error("Failed to write to file: " + filename + ": " + std::strerror(errno));
+        }
+        written += static_cast<std::size_t>(n);
+    }
+    return calls;
+}
+
+// Write-combining buffer over a borrowed descriptor. Small writes are copied into one large
+// buffer that goes to the kernel in a single write(2) when it fills up, on flush(), and on
+// destruction. Writes at least as large as the buffer bypass it.
+class BufferedWriter {
+private:
+    int fd_; // Borrowed from the FileHandle - not closed here
+    std::string filename_; // Store the filename for error messages
+    std::vector<std::byte> buffer_; // Pending bytes, flushed when full
+    std::size_t used_ = 0; // Bytes of buffer_ waiting to be written
+    std::size_t syscalls_ = 0; // write(2) calls issued so far
+
+    void flush_noexcept() noexcept {
+        try {
+            flush();
+        } catch (const std::exception& e) {
+            std::cerr << "BufferedWriter: dropped " << used_ << " bytes: " << e.what() << "\n";
+        }
+    }
+
+public:
+    BufferedWriter(int fd, std::string filename, std::size_t capacity)
+        : fd_(fd), filename_(std::move(filename)), buffer_(capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Write buffer capacity must be non-zero for file: " + filename_);
+        }
+    }
+
+    ~BufferedWriter() {
+        flush_noexcept(); // RAII: nothing buffered is lost when the writer goes away
+    }
+
+    BufferedWriter(const BufferedWriter&) = delete; // Disable copy constructor
+    BufferedWriter& operator=(const BufferedWriter&) = delete; // Disable copy assignment
+
+    BufferedWriter(BufferedWriter&& other) noexcept
+        : fd_(other.fd_), filename_(std::move(other.filename_)), buffer_(std::move(other.buffer_)),
+          used_(other.used_), syscalls_(other.syscalls_) {
+        other.fd_ = -1; // Leave 'other' in a valid but empty state
+        other.used_ = 0;
+    }
+
+    BufferedWriter& operator=(BufferedWriter&& other) noexcept {
+        if (this != &other) {
+            flush_noexcept(); // Our pending bytes belong to our descriptor
+            fd_ = other.fd_;
+            filename_ = std::move(other.filename_);
+            buffer_ = std::move(other.buffer_);
+            used_ = other.used_;
+            syscalls_ = other.syscalls_;
+            other.fd_ = -1;
+            other.used_ = 0;
+        }
+        return *this;
+    }
+
+    // Fast path: raw bytes, no formatting
+    void write(std::span<const std::byte> data) {
+        if (data.size() > buffer_.size() - used_) {
+            flush();
+            if (data.size() >= buffer_.size()) {
+                // Copying would only fill the buffer to flush it again
+                syscalls_ += write_fd_fully(fd_, reinterpret_cast<const char*>(data.data()), data.size(), filename_);
+                return;
+            }
+        }
+        if (!data.empty()) {
+            std::memcpy(buffer_.data() + used_, data.data(), data.size());
+            used_ += data.size();
+        }
+        if (used_ == buffer_.size()) {
+            flush(); // Flush-on-threshold
+        }
+    }
+
+    void write(std::string_view text) {
+        write(std::as_bytes(std::span<const char>(text.data(), text.size())));
+    }
+
+    // Hand every pending byte to the kernel (one write(2) unless it is short)
+    void flush() {
+        if (used_ == 0) {
+            return;
+        }
+        syscalls_ += write_fd_fully(fd_, reinterpret_cast<const char*>(buffer_.data()), used_, filename_);
+        used_ = 0;
+    }
+
+    std::size_t capacity() const noexcept { return buffer_.size(); }
+    std::size_t buffered() const noexcept { return used_; }
+    std::size_t syscalls() const noexcept { return syscalls_; }
+};
+
+enum class AsyncIoOp {
+    Read,
+    Write
+};
+
+// RAII owner of a heap buffer whose address and size are multiples of 'alignment', as O_DIRECT
+// transfers require (see FileHandle::enable_direct_io). The size is rounded up to the alignment.
+class AlignedBuffer {
+private:
+    std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t alignment_ = 0;
+
+    // Validates before rounding, so a zero alignment throws instead of dividing by zero
+    static std::size_t rounded_size(std::size_t size, std::size_t alignment) {
+        if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+            throw std::invalid_argument("Buffer alignment must be a power of two");
+        }
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+public:
+    AlignedBuffer() = default;
+
+    AlignedBuffer(std::size_t size, std::size_t alignment)
+        : size_(rounded_size(size, alignment)), alignment_(alignment) {
+        data_ = static_cast<std::byte*>(::operator new(size_, std::align_val_t{alignment_}));
+    }
+
+    ~AlignedBuffer() {
+        if (data_ != nullptr) {
+            ::operator delete(data_, std::align_val_t{alignment_});
+        }
+    }
+
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    AlignedBuffer(AlignedBuffer&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)),
+          alignment_(std::exchange(other.alignment_, 0)) {}
+
+    AlignedBuffer& operator=(AlignedBuffer&& other) noexcept {
+        if (this != &other) {
+            if (data_ != nullptr) {
+                ::operator delete(data_, std::align_val_t{alignment_});
+            }
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            alignment_ = std::exchange(other.alignment_, 0);
         }
         return *this;
     }
-    
-    // TODO: Add utility methods
-    bool is_open() const {
-        return is_open_; // Return the open state of the file
+
+    std::byte* data() noexcept { return data_; }
+    const std::byte* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    std::size_t alignment() const noexcept { return alignment_; }
+    std::span<std::byte> span() noexcept { return {data_, size_}; }
+    std::span<const std::byte> span() const noexcept { return {data_, size_}; }
+};
+
+// LZ77 block codec in the LZ4 sequence format, self-contained (no external library):
+//   token u8 (literal length hi nibble, match length - 4 lo nibble), 255-run length extensions,
+//   literals, match offset u16 LE (1..65535), match length extension. The last sequence is
+//   literals only. Blocks are independent: no history is shared between them.
+struct LzCodec {
+    static constexpr int hash_bits = 13;
+    static constexpr std::size_t min_match = 4;
+    static constexpr std::size_t last_literals = 5; // Matches never cover the final bytes of a block
+    static constexpr std::size_t match_start_margin = 12; // ...nor start this close to the end
+
+    static std::uint32_t load32(const std::byte* p) noexcept {
+        std::uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    static std::uint64_t load64(const std::byte* p) noexcept {
+        std::uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    static std::uint32_t hash(std::uint32_t sequence) noexcept {
+        return (sequence * 2654435761u) >> (32 - hash_bits);
+    }
+
+    static void put_length(std::vector<std::byte>& out, std::size_t length) {
+        for (; length >= 255; length -= 255) {
+            out.push_back(std::byte{255});
+        }
+        out.push_back(static_cast<std::byte>(length));
+    }
+
+    static void put_sequence(std::vector<std::byte>& out, const std::byte* literals, std::size_t literal_length,
+                             std::size_t offset, std::size_t match_length) {
+        const std::size_t match_code = match_length - min_match;
+        const auto token = static_cast<unsigned>((std::min<std::size_t>(literal_length, 15) << 4) |
+                                                 std::min<std::size_t>(match_code, 15));
+        out.push_back(static_cast<std::byte>(token));
+        if (literal_length >= 15) {
+            put_length(out, literal_length - 15);
+        }
+        out.insert(out.end(), literals, literals + literal_length);
+        out.push_back(static_cast<std::byte>(offset & 0xFF));
+        out.push_back(static_cast<std::byte>(offset >> 8));
+        if (match_code >= 15) {
+            put_length(out, match_code - 15);
+        }
+    }
+
+    // Append the compressed form of 'src' to 'out'
+    static void compress(std::span<const std::byte> src, std::vector<std::byte>& out) {
+        const std::byte* const base = src.data();
+        const std::size_t n = src.size();
+        std::size_t anchor = 0; // Start of pending literals
+        if (n > match_start_margin) {
+            std::array<std::uint32_t, std::size_t{1} << hash_bits> table{}; // Position + 1, 0 = empty
+            const std::size_t match_limit = n - last_literals;
+            std::size_t ip = 0;
+            while (ip < n - match_start_margin) {
+                const std::uint32_t sequence = load32(base + ip);
+                std::uint32_t& slot = table[hash(sequence)];
+                const std::size_t candidate = slot;
+                slot = static_cast<std::uint32_t>(ip + 1);
+                if (candidate == 0 || ip - (candidate - 1) > 65535 || load32(base + candidate - 1) != sequence) {
+                    ip += 1 + ((ip - anchor) >> 6); // Skip faster through incompressible data
+                    continue;
+                }
+                const std::size_t ref = candidate - 1;
+                std::size_t length = min_match;
+                for (;;) { // Extend 8 bytes at a time, then byte by byte near the end
+                    if (ip + length + 8 > match_limit) {
+                        while (ip + length < match_limit && base[ip + length] == base[ref + length]) {
+                            ++length;
+                        }
+                        break;
+                    }
+                    const std::uint64_t diff = load64(base + ip + length) ^ load64(base + ref + length);
+                    if (diff != 0) {
+                        length += static_cast<std::size_t>(__builtin_ctzll(diff)) / 8; // Little-endian
+                        break;
+                    }
+                    length += 8;
+                }
+                put_sequence(out, base + anchor, ip - anchor, ip - ref, length);
+                ip += length;
+                anchor = ip;
+            }
+        }
+        const std::size_t literal_length = n - anchor; // Final literals-only sequence
+        out.push_back(static_cast<std::byte>(std::min<std::size_t>(literal_length, 15) << 4));
+        if (literal_length >= 15) {
+            put_length(out, literal_length - 15);
+        }
+        out.insert(out.end(), base + anchor, base + n);
+    }
+
+    // Decode 'src' into 'dst', which must be exactly the original size. Throws on corrupt input.
+    static void decompress(std::span<const std::byte> src, std::span<std::byte> dst) {
+        const std::byte* ip = src.data();
+        const std::byte* const in_end = ip + src.size();
+        std::byte* op = dst.data();
+        std::byte* const out_end = op + dst.size();
+        const auto corrupt = [] { throw std::runtime_error("Corrupt compressed block"); };
+        const auto get_length = [&](std::size_t length) {
+            for (;;) {
+                if (ip == in_end) {
+                    corrupt();
+                }
+                const auto extra = std::to_integer<std::size_t>(*ip++);
+                length += extra;
+                if (extra != 255) {
+                    return length;
+                }
+            }
+        };
+        for (;;) {
+            if (ip == in_end) {
+                corrupt();
+            }
+            const auto token = std::to_integer<unsigned>(*ip++);
+            std::size_t literal_length = token >> 4;
+            if (literal_length == 15) {
+                literal_length = get_length(literal_length);
+            }
+            if (literal_length > static_cast<std::size_t>(in_end - ip) ||
+                literal_length > static_cast<std::size_t>(out_end - op)) {
+                corrupt();
+            }
+            std::memcpy(op, ip, literal_length);
+            op += literal_length;
+            ip += literal_length;
+            if (ip == in_end) {
+                break; // Last sequence has no match
+            }
+            if (in_end - ip < 2) {
+                corrupt();
+            }
+            const std::size_t offset = std::to_integer<std::size_t>(ip[0]) | (std::to_integer<std::size_t>(ip[1]) << 8);
+            ip += 2;
+            std::size_t match_length = (token & 15u) + min_match;
+            if ((token & 15u) == 15) {
+                match_length = get_length(match_length);
+            }
+            if (offset == 0 || offset > static_cast<std::size_t>(op - dst.data()) ||
+                match_length > static_cast<std::size_t>(out_end - op)) {
+                corrupt();
+            }
+            const std::byte* match = op - offset;
+            if (offset >= match_length) {
+                std::memcpy(op, match, match_length);
+                op += match_length;
+            } else {
+                for (std::size_t i = 0; i < match_length; ++i) { // Overlapping copy repeats a pattern
+                    *op++ = *match++;
+                }
+            }
+        }
+        if (op != out_end) {
+            corrupt();
+        }
+    }
+};
+
+// Frame header in front of every compressed block in a file:
+//   raw size u32 | stored size u32 (top bit set when the block is stored uncompressed)
+struct CompressedFrame {
+    static constexpr std::size_t header_size = 8;
+    static constexpr std::uint32_t stored_raw_flag = 0x80000000u;
+    static constexpr std::size_t max_block_size = std::size_t{16} << 20;
+};
+
+// Write side of FileHandle's compressed stream mode: gathers raw bytes into fixed-size blocks
+// and hands each compressed frame to a sink. Blocks smaller than block_size appear only when
+// the stream is flushed early.
+class BlockCompressor {
+private:
+    std::vector<std::byte> raw_; // Block being filled
+    std::size_t used_ = 0;
+    std::vector<std::byte> frame_; // Reused output buffer
+    std::size_t raw_bytes_ = 0; // Totals for ratio reporting
+    std::size_t stored_bytes_ = 0;
+
+    template <typename Sink>
+    void emit(Sink&& sink) {
+        const std::span<const std::byte> block(raw_.data(), used_);
+        frame_.resize(CompressedFrame::header_size);
+        LzCodec::compress(block, frame_);
+        auto stored = static_cast<std::uint32_t>(frame_.size() - CompressedFrame::header_size);
+        if (stored >= used_) { // Incompressible: store as-is
+            frame_.resize(CompressedFrame::header_size);
+            frame_.insert(frame_.end(), block.begin(), block.end());
+            stored = static_cast<std::uint32_t>(used_) | CompressedFrame::stored_raw_flag;
+        }
+        const auto raw_size = static_cast<std::uint32_t>(used_);
+        std::memcpy(frame_.data(), &raw_size, 4);
+        std::memcpy(frame_.data() + 4, &stored, 4);
+        sink(std::span<const std::byte>(frame_));
+        raw_bytes_ += used_;
+        stored_bytes_ += frame_.size();
+        used_ = 0;
+    }
+
+public:
+    explicit BlockCompressor(std::size_t block_size) : raw_(block_size) {
+        if (block_size == 0 || block_size > CompressedFrame::max_block_size) {
+            throw std::invalid_argument("Compressed block size must be between 1 byte and 16 MB");
+        }
+    }
+
+    template <typename Sink>
+    void write(std::span<const std::byte> data, Sink&& sink) {
+        while (!data.empty()) {
+            const std::size_t n = std::min(data.size(), raw_.size() - used_);
+            std::memcpy(raw_.data() + used_, data.data(), n);
+            used_ += n;
+            data = data.subspan(n);
+            if (used_ == raw_.size()) {
+                emit(sink);
+            }
+        }
+    }
+
+    // Compress whatever is pending as a (short) block
+    template <typename Sink>
+    void flush(Sink&& sink) {
+        if (used_ > 0) {
+            emit(sink);
+        }
+    }
+
+    std::size_t raw_bytes() const noexcept { return raw_bytes_; }
+    std::size_t stored_bytes() const noexcept { return stored_bytes_; }
+};
+
+// Read side of the compressed stream mode over a mapping of the file. Opening walks the frame
+// headers once to build a block table, so any block can be decompressed on its own: seek by
+// raw offset with block_containing(), or decompress everything in parallel with read_all().
+class CompressedFileReader {
+private:
+    struct Block {
+        std::size_t frame_offset; // Start of the frame payload in the file
+        std::size_t stored_size;
+        std::size_t raw_offset; // Position of the block in the decompressed stream
+        std::size_t raw_size;
+        bool compressed;
+    };
+
+    MappedRegion region_;
+    std::vector<Block> blocks_;
+    std::size_t raw_size_ = 0;
+
+    std::span<const std::byte> bytes() const noexcept {
+        return std::as_bytes(std::span<const char>(region_.data(), region_.size()));
+    }
+
+public:
+    explicit CompressedFileReader(MappedRegion region) : region_(std::move(region)) {
+        const std::span<const std::byte> file = bytes();
+        for (std::size_t pos = 0; pos < file.size();) {
+            if (file.size() - pos < CompressedFrame::header_size) {
+                throw std::runtime_error("Truncated compressed frame header");
+            }
+            std::uint32_t raw = 0;
+            std::uint32_t stored = 0;
+            std::memcpy(&raw, file.data() + pos, 4);
+            std::memcpy(&stored, file.data() + pos + 4, 4);
+            const bool compressed = (stored & CompressedFrame::stored_raw_flag) == 0;
+            const std::size_t stored_size = stored & ~CompressedFrame::stored_raw_flag;
+            pos += CompressedFrame::header_size;
+            if (raw > CompressedFrame::max_block_size || stored_size > file.size() - pos ||
+                (!compressed && stored_size != raw)) {
+                throw std::runtime_error("Corrupt compressed frame header");
+            }
+            blocks_.push_back(Block{pos, stored_size, raw_size_, raw, compressed});
+            raw_size_ += raw;
+            pos += stored_size;
+        }
+    }
+
+    std::size_t block_count() const noexcept { return blocks_.size(); }
+    std::size_t raw_size() const noexcept { return raw_size_; }
+    std::size_t block_raw_offset(std::size_t k) const { return blocks_.at(k).raw_offset; }
+    std::size_t block_raw_size(std::size_t k) const { return blocks_.at(k).raw_size; }
+
+    // Index of the block holding decompressed byte 'raw_offset'
+    std::size_t block_containing(std::size_t raw_offset) const {
+        if (raw_offset >= raw_size_) {
+            throw std::out_of_range("Offset past the end of the compressed stream");
+        }
+        const auto it = std::upper_bound(blocks_.begin(), blocks_.end(), raw_offset,
+                                         [](std::size_t offset, const Block& b) { return offset < b.raw_offset; });
+        return static_cast<std::size_t>(it - blocks_.begin()) - 1;
+    }
+
+    // Decompress block k into 'out', which must hold block_raw_size(k) bytes
+    void decompress_block(std::size_t k, std::span<std::byte> out) const {
+        const Block& block = blocks_.at(k);
+        if (out.size() < block.raw_size) {
+            throw std::invalid_argument("Output buffer too small for block " + std::to_string(k));
+        }
+        const std::span<const std::byte> payload = bytes().subspan(block.frame_offset, block.stored_size);
+        if (block.compressed) {
+            LzCodec::decompress(payload, out.first(block.raw_size));
+        } else {
+            std::memcpy(out.data(), payload.data(), payload.size());
+        }
+    }
+
+    // Decompress the whole stream, splitting the blocks across 'threads' threads
+    std::string read_all(unsigned threads = 1) const {
+        std::string out(raw_size_, '\0');
+        const auto target = std::as_writable_bytes(std::span<char>(out));
+        const std::size_t workers = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(blocks_.size(), 1));
+        std::vector<std::exception_ptr> errors(workers);
+        const auto work = [&](std::size_t w) {
+            try {
+                for (std::size_t k = w * blocks_.size() / workers; k < (w + 1) * blocks_.size() / workers; ++k) {
+                    decompress_block(k, target.subspan(blocks_[k].raw_offset, blocks_[k].raw_size));
+                }
+            } catch (...) {
+                errors[w] = std::current_exception();
+            }
+        };
+        std::vector<std::thread> pool;
+        for (std::size_t w = 1; w < workers; ++w) {
+            pool.emplace_back(work, w);
+        }
+        work(0);
+        for (auto& t : pool) {
+            t.join();
+        }
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+        return out;
+    }
+};
+
+// One positional (pread/pwrite-style) operation handed to an AsyncIoEngine. 'complete' runs on
+// an engine thread with the bytes transferred, or with the errno value when the operation failed.
+// The buffer must stay valid until then.
+struct AsyncIoRequest {
+    AsyncIoOp op;
+    int fd;
+    void* buffer;
+    std::size_t length;
+    off_t offset;
+    std::function<void(std::size_t bytes, int error)> complete;
+};
+
+// Backend that runs AsyncIoRequests off the calling thread. Destroying an engine waits for
+// every operation already submitted to it.
+class AsyncIoEngine {
+public:
+    AsyncIoEngine() = default;
+    virtual ~AsyncIoEngine() = default;
+
+    AsyncIoEngine(const AsyncIoEngine&) = delete;
+    AsyncIoEngine& operator=(const AsyncIoEngine&) = delete;
+    AsyncIoEngine(AsyncIoEngine&&) = delete;
+    AsyncIoEngine& operator=(AsyncIoEngine&&) = delete;
+
+    virtual void submit(AsyncIoRequest request) = 0;
+    virtual const char* name() const noexcept = 0;
+};
+
+// Fallback backend: a fixed set of threads running blocking pread/pwrite
+class ThreadPoolIoEngine final : public AsyncIoEngine {
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<AsyncIoRequest> queue_; // Submitted but not yet picked up
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+
+    static void run(AsyncIoRequest& request) {
+        ssize_t n = 0;
+        do {
+            n = request.op == AsyncIoOp::Read
+                    ? ::pread(request.fd, request.buffer, request.length, request.offset)
+                    : ::pwrite(request.fd, request.buffer, request.length, request.offset);
+        } while (n < 0 && errno == EINTR);
+        request.complete(n < 0 ? 0 : static_cast<std::size_t>(n), n < 0 ? errno : 0);
+    }
+
+    void work() {
+        for (;;) {
+            AsyncIoRequest request;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [&] { return stop_ || !queue_.empty(); });
+                if (queue_.empty()) {
+                    return; // Stopped and drained
+                }
+                request = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            run(request);
+        }
+    }
+
+public:
+    explicit ThreadPoolIoEngine(unsigned threads = 8) {
+        for (unsigned i = 0; i < std::max(threads, 1u); ++i) {
+            workers_.emplace_back(&ThreadPoolIoEngine::work, this);
+        }
+    }
+
+    ~ThreadPoolIoEngine() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join(); // Workers finish the queue before exiting
+        }
+    }
+
+    ThreadPoolIoEngine(const ThreadPoolIoEngine&) = delete;
+    ThreadPoolIoEngine& operator=(const ThreadPoolIoEngine&) = delete;
+    ThreadPoolIoEngine(ThreadPoolIoEngine&&) = delete;
+    ThreadPoolIoEngine& operator=(ThreadPoolIoEngine&&) = delete;
+
+    void submit(AsyncIoRequest request) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(std::move(request));
+        }
+        cv_.notify_one();
+    }
+
+    const char* name() const noexcept override { return "thread-pool"; }
+};
+
+// io_uring backend driven through the raw syscalls (no liburing): submissions go into the
+// shared SQ ring under a mutex, and one reaper thread waits on the CQ ring and runs the
+// completions. At most 'queue_depth' operations are in flight; submit() blocks beyond that.
+class IoUringEngine final : public AsyncIoEngine {
+private:
+    int ring_fd_ = -1;
+    void* sq_ring_ = MAP_FAILED;
+    std::size_t sq_ring_size_ = 0;
+    void* cq_ring_ = MAP_FAILED; // Same mapping as sq_ring_ with IORING_FEAT_SINGLE_MMAP
+    std::size_t cq_ring_size_ = 0;
+    void* sqes_map_ = MAP_FAILED;
+    std::size_t sqes_size_ = 0;
+
+    io_uring_sqe* sqes_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+
+    unsigned depth_ = 0; // Max operations in flight (the SQ size)
+    unsigned in_flight_ = 0;
+    std::mutex mutex_; // Guards the SQ ring and in_flight_
+    std::condition_variable slot_free_;
+    std::thread reaper_;
+
+    static constexpr std::uint64_t shutdown_tag = 0; // user_data of the NOP that stops the reaper
+
+    int enter(unsigned to_submit, unsigned min_complete, unsigned flags) const {
+        return static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete, flags, nullptr, 0));
+    }
+
+    void release() noexcept {
+        if (sqes_map_ != MAP_FAILED) {
+            ::munmap(sqes_map_, sqes_size_);
+        }
+        if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_) {
+            ::munmap(cq_ring_, cq_ring_size_);
+        }
+        if (sq_ring_ != MAP_FAILED) {
+            ::munmap(sq_ring_, sq_ring_size_);
+        }
+        if (ring_fd_ >= 0) {
+            ::close(ring_fd_);
+        }
+    }
+
+    // Caller holds mutex_. Returns 0, or the errno of a hard io_uring_enter failure; the kernel
+    // consumed nothing then, so the tail is rolled back and the SQE never reaches the reaper.
+    int push_sqe(const io_uring_sqe& sqe) noexcept {
+        const unsigned tail = *sq_tail_; // Only submitters (under mutex_) move the tail
+        const unsigned index = tail & sq_mask_;
+        sqes_[index] = sqe;
+        sq_array_[index] = index;
+        std::atomic_ref<unsigned>(*sq_tail_).store(tail + 1, std::memory_order_release);
+        while (enter(1, 0, 0) < 0) {
+            if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                const int error = errno;
+                std::atomic_ref<unsigned>(*sq_tail_).store(tail, std::memory_order_release);
+                return error;
+            }
+        }
+        return 0;
+    }
+
+    void reap_loop() {
+        for (;;) {
+            enter(0, 1, IORING_ENTER_GETEVENTS); // Sleep until at least one completion (EINTR just loops)
+            unsigned head = *cq_head_; // Only this thread moves the head
+            const unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+            unsigned reaped = 0;
+            bool stop = false;
+            for (unsigned i = head; i != tail; ++i) {
+                if (cqes_[i & cq_mask_].user_data == shutdown_tag) {
+                    stop = true;
+                } else {
+                    ++reaped;
+                }
+            }
+            {
+                // Every CQE seen here was submitted under mutex_, so taking it also orders the
+                // submitter's writes to the requests before the completions below
+                std::lock_guard<std::mutex> lock(mutex_);
+                in_flight_ -= reaped;
+            }
+            slot_free_.notify_all();
+            for (; head != tail; ++head) {
+                const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+                if (cqe.user_data == shutdown_tag) {
+                    continue;
+                }
+                std::unique_ptr<AsyncIoRequest> request(reinterpret_cast<AsyncIoRequest*>(cqe.user_data));
+                request->complete(cqe.res < 0 ? 0 : static_cast<std::size_t>(cqe.res), cqe.res < 0 ? -cqe.res : 0);
+            }
+            std::atomic_ref<unsigned>(*cq_head_).store(head, std::memory_order_release);
+            if (stop) {
+                return;
+            }
+        }
+    }
+
+public:
+    // Throws std::runtime_error when the kernel (or a seccomp filter) refuses io_uring
+    explicit IoUringEngine(unsigned queue_depth = 256) {
+        io_uring_params params{};
+        ring_fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, std::max(queue_depth, 1u), &params));
+        if (ring_fd_ < 0) {
+            throw std::runtime_error(std::string("io_uring_setup failed: ") + std::strerror(errno));
+        }
+        try {
+            sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (single_mmap) {
+                sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+            }
+            sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                              IORING_OFF_SQ_RING);
+            if (sq_ring_ == MAP_FAILED) {
+                throw std::runtime_error(std::string("Failed to map io_uring SQ ring: ") + std::strerror(errno));
+            }
+            cq_ring_ = single_mmap ? sq_ring_
+                                   : ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                            ring_fd_, IORING_OFF_CQ_RING);
+            if (cq_ring_ == MAP_FAILED) {
+                throw std::runtime_error(std::string("Failed to map io_uring CQ ring: ") + std::strerror(errno));
+            }
+            sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+            sqes_map_ = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                               IORING_OFF_SQES);
+            if (sqes_map_ == MAP_FAILED) {
+                throw std::runtime_error(std::string("Failed to map io_uring SQEs: ") + std::strerror(errno));
+            }
+        } catch (...) {
+            release();
+            throw;
+        }
+
+        char* sq = static_cast<char*>(sq_ring_);
+        char* cq = static_cast<char*>(cq_ring_);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        sqes_ = static_cast<io_uring_sqe*>(sqes_map_);
+        depth_ = params.sq_entries;
+        reaper_ = std::thread(&IoUringEngine::reap_loop, this);
+    }
+
+    ~IoUringEngine() override {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            slot_free_.wait(lock, [&] { return in_flight_ == 0; }); // Let submitted operations finish
+            io_uring_sqe nop{};
+            nop.opcode = IORING_OP_NOP;
+            nop.user_data = shutdown_tag;
+            if (const int error = push_sqe(nop); error != 0) {
+                std::cerr << "IoUringEngine: io_uring_enter failed: " << std::strerror(error) << "\n";
+                std::terminate(); // The reaper would never wake up
+            }
+        }
+        reaper_.join();
+        release();
+    }
+
+    IoUringEngine(const IoUringEngine&) = delete;
+    IoUringEngine& operator=(const IoUringEngine&) = delete;
+    IoUringEngine(IoUringEngine&&) = delete;
+    IoUringEngine& operator=(IoUringEngine&&) = delete;
+
+    void submit(AsyncIoRequest request) override {
+        auto owned = std::make_unique<AsyncIoRequest>(std::move(request));
+        io_uring_sqe sqe{};
+        sqe.opcode = owned->op == AsyncIoOp::Read ? IORING_OP_READ : IORING_OP_WRITE;
+        sqe.fd = owned->fd;
+        sqe.addr = reinterpret_cast<std::uint64_t>(owned->buffer);
+        sqe.len = static_cast<std::uint32_t>(std::min<std::size_t>(owned->length, UINT32_MAX)); // Longer requests complete short
+        sqe.off = static_cast<std::uint64_t>(owned->offset);
+        sqe.user_data = reinterpret_cast<std::uint64_t>(owned.get());
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        slot_free_.wait(lock, [&] { return in_flight_ < depth_; });
+        const int error = push_sqe(sqe);
+        if (error == 0) {
+            ++in_flight_;
+            owned.release(); // Submitted: the reaper takes ownership back from the CQE
+            return;
+        }
+        lock.unlock();
+        owned->complete(0, error); // Never reached the kernel: report it like a failed CQE
+    }
+
+    const char* name() const noexcept override { return "io_uring"; }
+};
+
+// Pick io_uring when the kernel allows it, otherwise a fixed pool of blocking I/O threads
+inline std::unique_ptr<AsyncIoEngine> make_async_io_engine(unsigned queue_depth = 256, unsigned pool_threads = 8) {
+    try {
+        return std::make_unique<IoUringEngine>(queue_depth);
+    } catch (const std::runtime_error&) {
+        return std::make_unique<ThreadPoolIoEngine>(pool_threads);
+    }
+}
+
+// Async operations still using a FileHandle's descriptor. Shared with their completions so the
+// count survives moves of the handle; closing the handle waits for it to drop to zero.
+struct AsyncInFlight {
+    std::mutex mutex;
+    std::condition_variable idle;
+    std::size_t count = 0;
+};
+
+// TODO: Implement the FileHandle class
+class FileHandle {
+private:
+    int fd_; // POSIX file descriptor owned by this handle (-1 when empty)
+    std::string filename_; // Store the filename for reference
+    bool is_open_; // Track if the file is open
+    std::optional<BufferedWriter> write_buffer_; // Engaged once enable_write_buffer() is called
+    std::optional<BlockCompressor> compressor_; // Engaged once enable_compression() is called
+    std::size_t direct_alignment_ = 0; // Non-zero while O_DIRECT is set (see enable_direct_io)
+    std::shared_ptr<AsyncInFlight> async_in_flight_; // Created by the first async operation
+    static inline std::atomic<bool> trace_{true}; // Print close/move messages (see set_tracing)
+
+    std::size_t read_fully(char* buffer, std::size_t size) {
+        return read_fd_fully(fd_, buffer, size, filename_);
+    }
+
+    void write_fully(const char* data, std::size_t size) {
+        write_fd_fully(fd_, data, size, filename_);
+    }
+
+    // Bytes as they go into the file (compressed frames in compressed mode)
+    void write_stored(std::span<const std::byte> data) {
+        if (write_buffer_) {
+            write_buffer_->write(data);
+        } else {
+            write_fully(reinterpret_cast<const char*>(data.data()), data.size());
+        }
+    }
+
+    // Emit the final partial block and leave compressed mode; errors are dropped as in close
+    void finish_compression() noexcept {
+        if (compressor_) {
+            try {
+                compressor_->flush([this](std::span<const std::byte> frame) { write_stored(frame); });
+            } catch (const std::exception& e) {
+                std::cerr << "FileHandle: dropped last compressed block of " << filename_ << ": " << e.what() << "\n";
+            }
+            compressor_.reset();
+        }
+    }
+
+    // Run readv/writev until every byte described by 'iov' is transferred, advancing
+    // partially transferred entries in place. Returns the bytes moved (short only at EOF).
+    template <typename VecSyscall>
+    std::size_t transfer_vec_fully(VecSyscall syscall, iovec* iov, int count, const char* what) {
+        std::size_t total = 0;
+        while (count > 0) {
+            const ssize_t n = syscall(iov, count);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue; // Interrupted by a signal - retry
+                }
+                throw std::runtime_error(std::string("Failed to ") + what + " file: " + filename_ + ": " + std::strerror(errno));
+            }
+            if (n == 0) {
+                break; // EOF (reads only)
+            }
+            auto left = static_cast<std::size_t>(n);
+            total += left;
+            while (count > 0 && left >= iov->iov_len) {
+                left -= iov->iov_len; // Entry fully transferred
+                ++iov;
+                --count;
+            }
+            if (count > 0) {
+                iov->iov_base = static_cast<char*>(iov->iov_base) + left; // Partial entry: retry the rest
+                iov->iov_len -= left;
+            }
+        }
+        return total;
+    }
+
+    // Feed the buffers to 'syscall' in batches that fit a stack iovec array
+    template <typename Buffers, typename VecSyscall>
+    std::size_t transfer_vec(const Buffers& buffers, VecSyscall syscall, const char* what) {
+        constexpr std::size_t batch = 64; // Well below IOV_MAX
+        std::array<iovec, batch> iov{};
+        std::size_t total = 0;
+        std::size_t expected = 0;
+        auto it = buffers.begin();
+        while (it != buffers.end()) {
+            std::size_t count = 0;
+            for (; it != buffers.end() && count < batch; ++it, ++count) {
+                iov[count].iov_base = const_cast<std::byte*>(it->data()); // iovec is shared by readv and writev
+                iov[count].iov_len = it->size();
+                expected += it->size();
+            }
+            total += transfer_vec_fully(syscall, iov.data(), static_cast<int>(count), what);
+            if (total < expected) {
+                break; // EOF part-way through a read
+            }
+        }
+        return total;
+    }
+
+    // Block until no async operation is using the descriptor any more
+    void wait_for_async_io() noexcept {
+        if (async_in_flight_) {
+            std::unique_lock<std::mutex> lock(async_in_flight_->mutex);
+            async_in_flight_->idle.wait(lock, [&] { return async_in_flight_->count == 0; });
+        }
+    }
+
+    std::future<std::size_t> submit_async(AsyncIoEngine& engine, AsyncIoOp op, void* buffer, std::size_t length, off_t offset) {
+        if (!is_open_) {
+            throw std::runtime_error("File is not open for async I/O: " + filename_);
+        }
+        if (!async_in_flight_) {
+            async_in_flight_ = std::make_shared<AsyncInFlight>();
+        }
+        auto promise = std::make_shared<std::promise<std::size_t>>(); // std::function needs a copyable callback
+        std::future<std::size_t> result = promise->get_future();
+        auto in_flight = async_in_flight_;
+        {
+            std::lock_guard<std::mutex> lock(in_flight->mutex);
+            ++in_flight->count;
+        }
+        const auto done = [in_flight] {
+            {
+                std::lock_guard<std::mutex> lock(in_flight->mutex);
+                --in_flight->count;
+            }
+            in_flight->idle.notify_all();
+        };
+        try {
+            engine.submit(AsyncIoRequest{op, fd_, buffer, length, offset,
+                                         [promise, done, filename = filename_](std::size_t bytes, int error) {
+                                             if (error != 0) {
+                                                 promise->set_exception(std::make_exception_ptr(std::runtime_error(
+                                                     "Async I/O failed on file: " + filename + ": " + std::strerror(error))));
+                                             } else {
+                                                 promise->set_value(bytes);
+                                             }
+                                             done();
+                                         }});
+        } catch (...) {
+            done();
+            throw;
+        }
+        return result;
+    }
+
+    static constexpr std::size_t copy_chunk = std::size_t{1} << 30; // Per-syscall cap for the kernel copy paths
+
+    // Errors meaning "this mechanism does not apply to these descriptors", as opposed to I/O failures
+    static bool copy_unsupported(int error) noexcept {
+        return error == ENOSYS || error == EINVAL || error == EXDEV || error == EOPNOTSUPP || error == EBADF ||
+               error == ESPIPE;
+    }
+
+    // Run an in-kernel copy step until it reports EOF. Returns false (with 'total' updated for any
+    // progress so far) when the mechanism is unsupported, so the caller can fall back.
+    template <typename CopyStep>
+    bool kernel_copy(std::size_t& total, CopyStep step) {
+        for (;;) {
+            const ssize_t n = step();
+            if (n > 0) {
+                total += static_cast<std::size_t>(n);
+            } else if (n == 0) {
+                return true; // EOF
+            } else if (errno == EINTR) {
+                continue;
+            } else if (copy_unsupported(errno)) {
+                return false;
+            } else {
+                throw std::runtime_error("Failed to copy file: " + filename_ + ": " + std::strerror(errno));
+            }
+        }
+    }
+
+    // file -> pipe -> file with splice(2), for descriptor pairs copy_file_range/sendfile reject
+    bool splice_copy(std::size_t& total, int out_fd) {
+        std::array<int, 2> pipe_fds{};
+        if (::pipe2(pipe_fds.data(), O_CLOEXEC) != 0) {
+            return false;
+        }
+        struct PipeCloser { // RAII for the intermediate pipe
+            std::array<int, 2>& fds;
+            ~PipeCloser() {
+                ::close(fds[0]);
+                ::close(fds[1]);
+            }
+        } closer{pipe_fds};
+        ::fcntl(pipe_fds[1], F_SETPIPE_SZ, 1 << 20); // Best effort: fewer round trips with a bigger pipe
+
+        for (;;) {
+            ssize_t in = 0;
+            do {
+                in = ::splice(fd_, nullptr, pipe_fds[1], nullptr, copy_chunk, SPLICE_F_MOVE);
+            } while (in < 0 && errno == EINTR);
+            if (in == 0) {
+                return true; // EOF
+            }
+            if (in < 0) {
+                if (copy_unsupported(errno)) {
+                    return false; // Nothing is left in the pipe, so falling back is safe
+                }
+                throw std::runtime_error("Failed to splice from file: " + filename_ + ": " + std::strerror(errno));
+            }
+            for (auto left = static_cast<std::size_t>(in); left > 0;) {
+                const ssize_t out = ::splice(pipe_fds[0], nullptr, out_fd, nullptr, left, SPLICE_F_MOVE);
+                if (out < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    // Bytes already in the pipe would be lost by a fallback, so this is fatal
+                    throw std::runtime_error("Failed to splice into copy of: " + filename_ + ": " + std::strerror(errno));
+                }
+                left -= static_cast<std::size_t>(out);
+                total += static_cast<std::size_t>(out);
+            }
+        }
+    }
+
+    // Direct I/O alignment the filesystem asks for (statx STATX_DIOALIGN), 0 if it has no direct I/O
+    std::size_t direct_io_alignment() const {
+#ifdef STATX_DIOALIGN
+        struct statx stx {};
+        if (::statx(fd_, "", AT_EMPTY_PATH, STATX_DIOALIGN, &stx) == 0 && (stx.stx_mask & STATX_DIOALIGN) != 0) {
+            return std::max<std::size_t>(stx.stx_dio_mem_align, stx.stx_dio_offset_align);
+        }
+#endif
+        return 4096; // Page alignment satisfies every block device
+    }
+
+    void set_direct_flag(bool enabled) {
+        const int flags = ::fcntl(fd_, F_GETFL);
+        if (flags < 0 || ::fcntl(fd_, F_SETFL, enabled ? flags | O_DIRECT : flags & ~O_DIRECT) != 0) {
+            throw std::runtime_error("Failed to change O_DIRECT on file: " + filename_ + ": " + std::strerror(errno));
+        }
+    }
+
+    void check_direct_alignment(const void* buffer, std::size_t length, off_t offset) const {
+        const std::size_t mask = direct_alignment_ - 1;
+        if ((reinterpret_cast<std::uintptr_t>(buffer) & mask) != 0 || (length & mask) != 0 ||
+            (static_cast<std::size_t>(offset) & mask) != 0) {
+            throw std::invalid_argument("Direct I/O on " + filename_ + " needs " + std::to_string(direct_alignment_) +
+                                        "-byte aligned buffer, length and offset");
+        }
+    }
+
+    // pread/pwrite until 'size' bytes move or EOF. Under O_DIRECT a filesystem may still refuse
+    // the transfer with EINVAL; the handle then drops back to buffered I/O and retries.
+    template <typename Syscall>
+    std::size_t positional_fully(Syscall syscall, char* buffer, std::size_t size, off_t offset, const char* what,
+                                 bool is_read) {
+        std::size_t done = 0;
+        while (done < size) {
+            const ssize_t n = syscall(buffer + done, size - done, offset + static_cast<off_t>(done));
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno == EINVAL && direct_alignment_ != 0) {
+                    disable_direct_io();
+                    continue;
+                }
+                throw std::runtime_error(std::string("Failed to ") + what + " file: " + filename_ + ": " + std::strerror(errno));
+            }
+            if (n == 0) {
+                break; // EOF
+            }
+            done += static_cast<std::size_t>(n);
+            if (is_read && direct_alignment_ != 0 && done % direct_alignment_ != 0) {
+                break; // Short direct read ends at EOF; the next offset would be unaligned
+            }
+        }
+        return done;
+    }
+
+    struct stat stat_file() const {
+        struct stat st {};
+        if (::fstat(fd_, &st) != 0) {
+            throw std::runtime_error("Failed to stat file: " + filename_ + ": " + std::strerror(errno));
+        }
+        return st;
+    }
+
+public:
+    // TODO: Constructor should open the file and handle errors
+    explicit FileHandle(const std::string& filename, std::ios::openmode mode = std::ios::in | std::ios::out) { // explicit is used to prevent implicit conversions
+        // Your implementation here
+        filename_ = filename; // Store the filename for reference 
+        fd_ = ::open(filename.c_str(), to_open_flags(mode), 0666); // Same permissions std::fopen would use
+        if (fd_ < 0) {
+            throw std::runtime_error("Failed to open file: " + filename + ": " + std::strerror(errno));
+        }
+        is_open_ = true; // Set the file as open
+    }
+
+    
+    // TODO: Destructor should automatically close the file
+    ~FileHandle() {
+        if (!is_open_) {
+            return; // If the file is not open, nothing to close
+        }
+        finish_compression(); // The last partial block goes through the write buffer
+        write_buffer_.reset(); // Flush buffered writes while the descriptor is still open
+        wait_for_async_io(); // In-flight async operations still use the descriptor
+        ::close(fd_); // Close the file
+        is_open_ = false; // Mark the file as closed
+        if (trace_.load(std::memory_order_relaxed)) {
+            std::cout << "File '" << filename_ << "' closed automatically.\n";
+        }
+        
+        // Your implementation here
+    }
+    
+    // TODO: Disable copy constructor and copy assignment (Rule of 5)
+    FileHandle(const FileHandle&) = delete; // Disable copy constructor
+    FileHandle& operator=(const FileHandle&) = delete; // Disable copy assignment
+    
+    // TODO: Implement move constructor and move assignment
+    FileHandle(FileHandle&& other) noexcept {
+        fd_ = other.fd_; // Transfer ownership of the descriptor
+        filename_ = std::move(other.filename_); // Transfer ownership of the filename
+        is_open_ = other.is_open_; // Transfer the open state
+        write_buffer_ = std::move(other.write_buffer_); // Pending bytes follow the descriptor
+        other.write_buffer_.reset();
+        compressor_ = std::move(other.compressor_); // So does a partially filled block
+        other.compressor_.reset();
+        direct_alignment_ = std::exchange(other.direct_alignment_, 0);
+        async_in_flight_ = std::move(other.async_in_flight_); // So do in-flight async operations
+        other.fd_ = -1;
+        other.is_open_ = false; // Leave 'other' in a valid but empty state
+        if (trace_.load(std::memory_order_relaxed)) {
+            std::cout << "FileHandle moved from '" << other.filename_ << "' to '" << filename_ << "'\n";
+        }
+        other.filename_.clear(); // Clear the filename of the moved-from object
+    }
+    
+    FileHandle& operator=(FileHandle&& other) noexcept {
+        if (this != &other) { // Self-assignment check? whats this? this is a this pointer that points to the current object
+            // If the current file is open, close it first
+            if (is_open_) {
+                finish_compression();
+                write_buffer_.reset(); // Flush our pending writes first
+                wait_for_async_io();
+                ::close(fd_); // Close the current file if open
+            }
+            fd_ = other.fd_; // Transfer ownership of the descriptor
+            filename_ = std::move(other.filename_); // Transfer ownership of the filename
+            is_open_ = other.is_open_; // Transfer the open state
+            write_buffer_ = std::move(other.write_buffer_); // Pending bytes follow the descriptor
+            other.write_buffer_.reset();
+            compressor_ = std::move(other.compressor_);
+            other.compressor_.reset();
+            direct_alignment_ = std::exchange(other.direct_alignment_, 0);
+            async_in_flight_ = std::move(other.async_in_flight_);
+            other.fd_ = -1;
+            other.is_open_ = false; // Leave 'other' in a valid but empty state
+            if (trace_.load(std::memory_order_relaxed)) {
+                std::cout << "FileHandle moved from '" << other.filename_ << "' to '" << filename_ << "'\n";
+            }
+            other.filename_.clear(); // Clear the filename of the moved-from object
+        }
+        return *this;
+    }
+    
+    // TODO: Add utility methods
+    bool is_open() const {
+        return is_open_; // Return the open state of the file
+    }
+
+    // Turn the close/move trace off for every FileHandle (it is a locked stream write per
+    // close, which dominates in open-heavy loops)
+    static void set_tracing(bool enabled) noexcept {
+        trace_.store(enabled, std::memory_order_relaxed);
+    }
+
+    // Reposition the file offset used by read(), write() and friends
+    void seek(off_t offset) {
+        if (!is_open_) {
+            throw std::runtime_error("File is not open for seeking: " + filename_);
+        }
+        flush();
+        if (::lseek(fd_, offset, SEEK_SET) < 0) {
+            throw std::runtime_error("Failed to seek in file: " + filename_ + ": " + std::strerror(errno));
+        }
+    }
+
+    int native_handle() const {
+        return fd_; // Underlying descriptor, still owned by this handle
+    }
+
+    const std::string& filename() const {
+        return filename_;
+    }
+    
+    void write(const std::string& data) {
+        write(std::as_bytes(std::span<const char>(data.data(), data.size())));
+    }
+
+    // Unformatted fast path; goes through the compressor and the write buffer when enabled
+    void write(std::span<const std::byte> data) {
+        if (!is_open_) {
+            throw std::runtime_error("File is not open for writing: " + filename_);
+        }
+        if (compressor_) {
+            compressor_->write(data, [this](std::span<const std::byte> frame) { write_stored(frame); });
+        } else {
+            write_stored(data);
+        }
+    }
+
+    // Gather-write several buffers (e.g. header, payload, trailer) with writev(2), without
+    // concatenating them first. Short writes are retried until every byte is written.
+    void write_vec(std::initializer_list<std::span<const std::byte>> buffers) {
+        if (!is_open_) {
+            throw std::runtime_error("File is not open for writing: " + filename_);
+        }
+        flush(); // Keep ordering with previously buffered writes
+        transfer_vec(buffers, [this](const iovec* iov, int count) { return ::writev(fd_, iov, count); }, "write to");
+    }
+
+    // Scatter-read consecutive bytes of the file straight into several buffers with readv(2).
+    // Returns the bytes read, which is less than the total size only at EOF.
+    std::size_t read_vec(std::initializer_list<std::span<std::byte>> buffers) {
+        if (!is_open_) {
+            throw std::runtime_error("File is not open for reading: " + filename_);
+        }
+        flush();
+        return transfer_vec(buffers, [this](const iovec* iov, int count) { return ::readv(fd_, iov, count); }, "read from");
+    }
+
+    // Combine subsequent writes in a buffer of 'capacity' bytes (1-16 MB works well for logs).
+    // The buffer is flushed when full, on flush(), before any read or map of this handle,
+    // and when the handle is closed.
+    BufferedWriter& enable_write_buffer(std::size_t capacity = std::size_t{4} << 20) {
+        if (!is_open_) {
+            throw std::runtime_error("File is not open for writing: " + filename_);
+        }
+        write_buffer_.reset(); // Flush any previous buffer before replacing it
+        return write_buffer_.emplace(fd_, filename_, capacity);
+    }
+
+    // Bypass the page cache (O_DIRECT) so bulk scans do not evict everyone else's hot pages.
+    // Returns false, leaving the handle buffered, when the filesystem has no direct I/O. While
+    // enabled every transfer must be aligned to io_alignment() in address, length and offset, so
+    // use read_direct()/write_direct() with an AlignedBuffer; unaligned read()/write() fail with EINVAL.
+    bool enable_direct_io() {
+        if (!is_open_) {
+            throw std::runtime_error("File is not open for direct I/O: " + filename_);
+        }
+        if (write_buffer_ || compressor_) {
+            throw std::runtime_error("Direct I/O cannot be combined with a write buffer or compression: " + filename_);
+        }
+        const int flags = ::fcntl(fd_, F_GETFL);
+        if (flags < 0) {
+            throw std::runtime_error("Failed to get flags of file: " + filename_ + ": " + std::strerror(errno));
+        }
+        if (::fcntl(fd_, F_SETFL, flags | O_DIRECT) != 0) {
+            if (errno == EINVAL) {
+                return false; // Filesystem rejects O_DIRECT - stay on buffered I/O
+            }
+            throw std::runtime_error("Failed to enable O_DIRECT on file: " + filename_ + ": " + std::strerror(errno));
+        }
+        const std::size_t alignment = direct_io_alignment();
+        if (alignment == 0) { // statx says the filesystem has no direct I/O: undo, like EINVAL above
+            if (::fcntl(fd_, F_SETFL, flags) != 0) {
+                throw std::runtime_error("Failed to clear O_DIRECT on file: " + filename_ + ": " + std::strerror(errno));
+            }
+            return false;
+        }
+        direct_alignment_ = alignment;
+        return true;
+    }
+
+    void disable_direct_io() {
+        if (direct_alignment_ != 0) {
+            set_direct_flag(false);
+            direct_alignment_ = 0;
+        }
+    }
+
+    bool direct_io() const noexcept {
+        return direct_alignment_ != 0;
+    }
+
+    // Alignment read_direct()/write_direct() need (1 when the handle is buffered)
+    std::size_t io_alignment() const noexcept {
+        return direct_alignment_ != 0 ? direct_alignment_ : 1;
+    }
+
+    // Read up to buffer.size() bytes at 'offset' (pread semantics, short only at EOF). Works in
+    // both modes; in direct mode the buffer, its size and the offset must be aligned.
+    std::size_t read_direct(std::span<std::byte> buffer, off_t offset) {
+        if (!is_open_) {
+            throw std::runtime_error("File is not open for reading: " + filename_);
+        }
+        if (direct_alignment_ != 0) {
+            check_direct_alignment(buffer.data(), buffer.size(), offset);
+        }
+        return positional_fully([this](char* p, std::size_t n, off_t at) { return ::pread(fd_, p, n, at); },
+                                reinterpret_cast<char*>(buffer.data()), buffer.size(), offset, "read from", true);
+    }
+
+    // Write 'data' at 'offset'. In direct mode the buffer and offset must be aligned; the aligned
+    // part of the length goes straight to the device and an unaligned tail (the end of a file)
+    // is written through the page cache.
+    void write_direct(std::span<const std::byte> data, off_t offset) {
+        if (!is_open_) {
+            throw std::runtime_error("File is not open for writing: " + filename_);
+        }
+        const auto pwrite_at = [this](char* p, std::size_t n, off_t at) { return ::pwrite(fd_, p, n, at); };
+        auto* bytes = const_cast<char*>(reinterpret_cast<const char*>(data.data())); // pwrite only reads it
+        std::size_t tail = 0; // Start of the part that cannot go direct
+        if (direct_alignment_ != 0) {
+            tail = data.size() - data.size() % direct_alignment_;
+            check_direct_alignment(bytes, tail, offset);
+            positional_fully(pwrite_at, bytes, tail, offset, "write to", false);
+        }
+        if (tail < data.size()) {
+            const bool direct = direct_alignment_ != 0; // May have fallen back above
+            if (direct) {
+                set_direct_flag(false); // The tail cannot satisfy the length alignment
+            }
+            positional_fully(pwrite_at, bytes + tail, data.size() - tail, offset + static_cast<off_t>(tail), "write to", false);
+            if (direct) {
+                set_direct_flag(true);
+            }
+        }
+    }
+
+    // Compress subsequent write()s into independent LZ blocks of 'block_size' raw bytes, each
+    // stored as a frame (see CompressedFrame) that compressed_reader() can decode on its own.
+    // flush() - and so read(), map() and seek() - ends the current block early, so keep those
+    // rare while writing. write_vec, async_write and copy_to still move stored bytes unchanged.
+    BlockCompressor& enable_compression(std::size_t block_size = std::size_t{64} << 10) {
+        if (!is_open_) {
+            throw std::runtime_error("File is not open for writing: " + filename_);
+        }
+        flush(); // Close the previous compressor's last block
+        return compressor_.emplace(block_size);
+    }
+
+    // Map a file written in compressed mode and index its blocks for seeking and parallel reads
+    CompressedFileReader compressed_reader() {
+        return CompressedFileReader(map(MapMode::ReadOnly, MapAdvice::WillNeed));
+    }
+
+    // Push buffered writes (and a partially filled compressed block) to the kernel
+    void flush() {
+        if (compressor_) {
+            compressor_->flush([this](std::span<const std::byte> frame) { write_stored(frame); });
+        }
+        if (write_buffer_) {
+            write_buffer_->flush();
+        }
+    }
+
+    // Read up to buffer.size() bytes at 'offset' on an engine thread (pread semantics: the
+    // result is short only at EOF). The buffer must stay valid until the future is ready;
+    // the handle keeps its descriptor open until the operation finishes, even if it is closed first.
+    std::future<std::size_t> async_read(AsyncIoEngine& engine, std::span<char> buffer, off_t offset) {
+        return submit_async(engine, AsyncIoOp::Read, buffer.data(), buffer.size(), offset);
+    }
+
+    // Write 'data' at 'offset' on an engine thread (pwrite semantics; check the returned count)
+    std::future<std::size_t> async_write(AsyncIoEngine& engine, std::span<const std::byte> data, off_t offset) {
+        flush(); // Buffered writes land before the positional write
+        return submit_async(engine, AsyncIoOp::Write, const_cast<std::byte*>(data.data()), data.size(), offset);
+    }
+
+    // Result of copy_to()/transfer_to(): bytes moved and the mechanism that finished the job
+    enum class CopyMethod {
+        CopyFileRange, // copy_file_range(2): in-kernel, may reflink/offload on the filesystem
+        Sendfile, // sendfile(2): in-kernel page-cache copy
+        Splice, // splice(2) through a pipe: in-kernel, no user-space copy
+        Buffered // read(2)/write(2) through a 1 MB user-space buffer
+    };
+
+    struct CopyResult {
+        std::size_t bytes;
+        CopyMethod method;
+    };
+
+    static const char* method_name(CopyMethod method) noexcept {
+        switch (method) {
+            case CopyMethod::CopyFileRange: return "copy_file_range";
+            case CopyMethod::Sendfile: return "sendfile";
+            case CopyMethod::Splice: return "splice";
+            case CopyMethod::Buffered: return "buffered";
+        }
+        return "unknown";
+    }
+
+    // Copy from this handle's offset to EOF into 'destination' at its offset, without bringing
+    // the data into user space when the kernel can avoid it. Each mechanism is tried in order and
+    // the next one continues from where the previous stopped if it turns out to be unsupported.
+    CopyResult copy_to(FileHandle& destination) {
+        if (!is_open_ || !destination.is_open_) {
+            throw std::runtime_error("File is not open for copying: " + filename_ + " -> " + destination.filename_);
+        }
+        flush();
+        destination.flush();
+        std::size_t total = 0;
+        if (kernel_copy(total, [&] { return ::copy_file_range(fd_, nullptr, destination.fd_, nullptr, copy_chunk, 0); })) {
+            return {total, CopyMethod::CopyFileRange};
+        }
+        if (kernel_copy(total, [&] { return ::sendfile(destination.fd_, fd_, nullptr, copy_chunk); })) {
+            return {total, CopyMethod::Sendfile};
+        }
+        if (splice_copy(total, destination.fd_)) {
+            return {total, CopyMethod::Splice};
+        }
+        std::vector<char> buffer(std::size_t{1} << 20); // Last resort: bounded user-space buffer
+        for (;;) {
+            const std::size_t n = read_fully(buffer.data(), buffer.size());
+            if (n == 0) {
+                return {total, CopyMethod::Buffered};
+            }
+            destination.write_fully(buffer.data(), n);
+            total += n;
+        }
+    }
+
+    // Stream from this handle's offset to EOF into a pipe (or socket) the caller owns, with
+    // splice(2) and sendfile(2) as fallback. Blocks while the pipe is full.
+    CopyResult transfer_to(int pipe_fd) {
+        if (!is_open_) {
+            throw std::runtime_error("File is not open for transfer: " + filename_);
+        }
+        flush();
+        std::size_t total = 0;
+        if (kernel_copy(total, [&] { return ::splice(fd_, nullptr, pipe_fd, nullptr, copy_chunk, SPLICE_F_MOVE); })) {
+            return {total, CopyMethod::Splice};
+        }
+        if (kernel_copy(total, [&] { return ::sendfile(pipe_fd, fd_, nullptr, copy_chunk); })) {
+            return {total, CopyMethod::Sendfile};
+        }
+        std::vector<char> buffer(std::size_t{1} << 20);
+        for (;;) {
+            const std::size_t n = read_fully(buffer.data(), buffer.size());
+            if (n == 0) {
+                return {total, CopyMethod::Buffered};
+            }
+            write_fd_fully(pipe_fd, buffer.data(), n, "pipe");
+            total += n;
+        }
+    }
+
+    // Make everything written so far durable with fdatasync(2) (data, not timestamps)
+    void sync_data() {
+        if (!is_open_) {
+            throw std::runtime_error("File is not open for syncing: " + filename_);
+        }
+        flush();
+        if (::fdatasync(fd_) != 0) {
+            throw std::runtime_error("Failed to sync file: " + filename_ + ": " + std::strerror(errno));
+        }
+    }
+    
+    // Read everything from the current position to EOF. Regular files are sized with
+    // fstat so the buffer is allocated once and filled by a single read(2) in the common case.
+    std::string read() {
+        if (!is_open_) {
+            throw std::runtime_error("File is not open for reading: " + filename_);
+        }
+        flush(); // Read back our own buffered writes
+        const struct stat st = stat_file();
+        std::string content;
+        if (S_ISREG(st.st_mode)) {
+            const off_t pos = ::lseek(fd_, 0, SEEK_CUR);
+            const auto remaining = static_cast<std::size_t>(pos >= 0 && pos < st.st_size ? st.st_size - pos : 0);
+            content.resize(remaining); // One allocation for the whole file
+            content.resize(read_fully(content.data(), remaining)); // Shrink if the file was truncated meanwhile
+            return content;
+        }
+
+        // Pipes, sockets and procfs report no useful size - grow in 64 KB steps until EOF
+        constexpr std::size_t step = 64 * 1024;
+        std::size_t filled = 0;
+        for (;;) {
+            content.resize(filled + step);
+            const std::size_t n = read_fully(content.data() + filled, step);
+            filled += n;
+            if (n < step) {
+                break;
+            }
+        }
+        content.resize(filled);
+        return content;
+    }
+
+    // Read up to buffer.size() bytes from the current position into caller-owned storage,
+    // so hot loops can reuse one buffer across many files. Returns the bytes read (< size at EOF).
+    std::size_t read_into(std::span<char> buffer) {
+        if (!is_open_) {
+            throw std::runtime_error("File is not open for reading: " + filename_);
+        }
+        flush();
+        return read_fully(buffer.data(), buffer.size());
+    }
+
+    // Stream the rest of the file in fixed-size chunks with read-ahead on a background thread:
+    //   for (std::span<const char> chunk : fh.chunks(1 << 20)) { ... }
+    // Memory stays at two chunks however large the file is.
+    ChunkReader chunks(std::size_t chunk_size) {
+        if (!is_open_) {
+            throw std::runtime_error("File is not open for reading: " + filename_);
+        }
+        flush();
+        return ChunkReader(fd_, filename_, chunk_size);
+    }
+
+    // Iterate the lines of the file as string_views into a read-only mapping of it:
+    //   for (std::string_view line : fh.lines()) { ... }
+    MappedLines lines(MapAdvice advice = MapAdvice::Sequential) {
+        return MappedLines(map(MapMode::ReadOnly, advice));
+    }
+
+    // Map the whole file into memory instead of copying it through a read buffer.
+    // The returned region owns the pages and stays valid after this handle is closed.
+    // The handle must have been opened for reading (and writing, for MapMode::ReadWrite).
+    MappedRegion map(MapMode mode = MapMode::ReadOnly, MapAdvice advice = MapAdvice::Normal) {
+        if (!is_open_) {
+            throw std::runtime_error("File is not open for mapping: " + filename_);
+        }
+        flush(); // Buffered writes must be in the file before its pages are mapped
+        const auto size = static_cast<std::size_t>(stat_file().st_size);
+        if (size == 0) {
+            return MappedRegion(); // mmap rejects zero-length mappings
+        }
+
+        const int prot = mode == MapMode::ReadWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+        void* addr = ::mmap(nullptr, size, prot, MAP_SHARED, fd_, 0);
+        if (addr == MAP_FAILED) {
+            throw std::runtime_error("Failed to map file: " + filename_ + ": " + std::strerror(errno));
+        }
+
+        MappedRegion region(static_cast<char*>(addr), size, filename_);
+        region.advise(advice);
+        return region;
+    }
+};
+
+// Pool of open FileHandles keyed by (filename, open mode) for workloads that keep reopening the
+// same files. acquire() hands out a move-only Lease that owns the handle exclusively; when the
+// lease is destroyed the handle is rewound and goes back to the pool instead of being closed.
+// Reused handles for truncating modes ("w", "w+") are truncated again, as a fresh open would.
+// Idle handles are evicted least-recently-used first once more than max_open descriptors are
+// open; leased handles count toward the limit but are never taken away from their holder.
+// The cache must outlive its leases.
+class FileHandleCache {
+public:
+    struct Stats {
+        std::size_t hits = 0; // acquire() served from the pool
+        std::size_t misses = 0; // acquire() had to open the file
+        std::size_t evictions = 0; // Idle handles closed to stay under max_open
+        std::size_t open = 0; // Descriptors currently open (idle + leased)
+    };
+
+    class Lease {
+    private:
+        FileHandleCache* cache_;
+        std::string key_;
+        std::uint64_t generation_; // Invalidation generation of the file when acquired
+        std::unique_ptr<FileHandle> handle_; // Pooled handles never move: FileHandle's move traces to std::cout
+
+    public:
+        Lease(FileHandleCache* cache, std::string key, std::uint64_t generation, std::unique_ptr<FileHandle> handle)
+            : cache_(cache), key_(std::move(key)), generation_(generation), handle_(std::move(handle)) {}
+
+        ~Lease() {
+            if (handle_) {
+                cache_->give_back(std::move(key_), generation_, std::move(handle_));
+            }
+        }
+
+        Lease(const Lease&) = delete; // Disable copy constructor
+        Lease& operator=(const Lease&) = delete; // Disable copy assignment
+
+        Lease(Lease&& other) noexcept
+            : cache_(other.cache_), key_(std::move(other.key_)), generation_(other.generation_),
+              handle_(std::move(other.handle_)) {}
+
+        Lease& operator=(Lease&& other) noexcept {
+            if (this != &other) {
+                if (handle_) {
+                    cache_->give_back(std::move(key_), generation_, std::move(handle_)); // Return our handle first
+                }
+                cache_ = other.cache_;
+                key_ = std::move(other.key_);
+                generation_ = other.generation_;
+                handle_ = std::move(other.handle_);
+            }
+            return *this;
+        }
+
+        FileHandle& operator*() { return *handle_; }
+        FileHandle* operator->() { return handle_.get(); }
+        explicit operator bool() const noexcept { return handle_ != nullptr; }
+    };
+
+private:
+    struct IdleEntry {
+        std::string key;
+        std::unique_ptr<FileHandle> handle;
+    };
+
+    std::size_t max_open_;
+    mutable std::mutex mutex_;
+    std::list<IdleEntry> lru_; // Idle handles, most recently returned first
+    std::unordered_multimap<std::string, std::list<IdleEntry>::iterator> idle_; // key -> idle handles
+    std::unordered_map<std::string, std::uint64_t> generations_; // Bumped by invalidate(filename)
+    Stats stats_;
+
+    static std::string make_key(const std::string& filename, std::ios::openmode mode) {
+        return std::to_string(static_cast<int>(mode)) + ':' + filename;
+    }
+
+    static std::string filename_of(const std::string& key) {
+        return key.substr(key.find(':') + 1);
+    }
+
+    std::uint64_t generation_of(const std::string& filename) const {
+        const auto it = generations_.find(filename);
+        return it == generations_.end() ? 0 : it->second;
+    }
+
+    // Caller holds mutex_. Moves evicted handles into 'closing' so they are closed unlocked.
+    void unlink_idle(std::list<IdleEntry>::iterator entry, std::vector<std::unique_ptr<FileHandle>>& closing) {
+        auto [first, last] = idle_.equal_range(entry->key);
+        for (; first != last; ++first) {
+            if (first->second == entry) {
+                idle_.erase(first);
+                break;
+            }
+        }
+        closing.push_back(std::move(entry->handle));
+        lru_.erase(entry);
+        --stats_.open;
+    }
+
+    // Caller holds mutex_
+    void trim(std::vector<std::unique_ptr<FileHandle>>& closing) {
+        while (stats_.open > max_open_ && !lru_.empty()) {
+            unlink_idle(std::prev(lru_.end()), closing);
+            ++stats_.evictions;
+        }
+    }
+
+    void give_back(std::string key, std::uint64_t generation, std::unique_ptr<FileHandle> handle) noexcept {
+        std::vector<std::unique_ptr<FileHandle>> closing; // Destroyed after the lock is released
+        try {
+            handle->flush();
+            handle->seek(0); // The next lease starts at the beginning, like a fresh open
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (generation != generation_of(filename_of(key))) {
+                closing.push_back(std::move(handle)); // Invalidated while leased
+                --stats_.open;
+                return;
+            }
+            lru_.push_front(IdleEntry{key, std::move(handle)});
+            idle_.emplace(std::move(key), lru_.begin());
+            trim(closing);
+        } catch (const std::exception& e) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --stats_.open; // 'handle' is closed on return; it never made it back to the pool
+            std::cerr << "FileHandleCache: dropped handle: " << e.what() << "\n";
+        }
+    }
+
+public:
+    explicit FileHandleCache(std::size_t max_open = 1024) : max_open_(max_open) {}
+
+    FileHandleCache(const FileHandleCache&) = delete;
+    FileHandleCache& operator=(const FileHandleCache&) = delete;
+    FileHandleCache(FileHandleCache&&) = delete; // Leases point back at the cache
+    FileHandleCache& operator=(FileHandleCache&&) = delete;
+
+    // Lease an open handle for 'filename', reusing an idle one when possible
+    Lease acquire(const std::string& filename, std::ios::openmode mode = std::ios::in) {
+        std::string key = make_key(filename, mode);
+        std::uint64_t generation = 0;
+        std::vector<std::unique_ptr<FileHandle>> closing;
+        std::unique_ptr<FileHandle> reused;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            generation = generation_of(filename);
+            const auto hit = idle_.find(key);
+            if (hit != idle_.end()) {
+                const auto entry = hit->second;
+                idle_.erase(hit);
+                reused = std::move(entry->handle);
+                lru_.erase(entry);
+                ++stats_.hits;
+            } else {
+                ++stats_.misses;
+                ++stats_.open; // Reserve the slot before opening outside the lock
+                trim(closing);
+            }
+        }
+        if (reused) {
+            Lease lease(this, std::move(key), generation, std::move(reused));
+            if ((to_open_flags(mode) & O_TRUNC) != 0 && ::ftruncate(lease->native_handle(), 0) != 0) {
+                throw std::runtime_error("Failed to truncate cached file: " + filename + ": " + std::strerror(errno));
+            }
+            return lease;
+        }
+        closing.clear(); // Close evicted handles before opening a new descriptor
+        try {
+            return Lease(this, std::move(key), generation, std::make_unique<FileHandle>(filename, mode));
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --stats_.open;
+            throw;
+        }
+    }
+
+    // Close every idle handle for 'filename' now, and leased ones when they come back
+    // (e.g. after the file was replaced on disk)
+    void invalidate(const std::string& filename) {
+        std::vector<std::unique_ptr<FileHandle>> closing;
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++generations_[filename];
+        for (auto it = lru_.begin(); it != lru_.end();) {
+            const auto next = std::next(it);
+            if (filename_of(it->key) == filename) {
+                unlink_idle(it, closing);
+            }
+            it = next;
+        }
+    }
+
+    Stats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+};
+
+// Group-commit tunables for AppendLog
+struct AppendLogOptions {
+    // Extra time a commit waits for more records to join it. With 0 a batch is whatever
+    // arrived while the previous fdatasync was running, which already amortizes well.
+    std::chrono::microseconds max_batch_latency{0};
+    std::size_t max_batch_bytes = std::size_t{1} << 20; // Commit right away once this much is pending
+};
+
+// Durable append-only journal with group commit: any number of producer threads append records
+// into a shared buffer, and a single committer thread writes each batch with one write(2) plus
+// one fdatasync(2). The future returned by append() resolves once that record is on disk (or
+// carries the write/sync error). The destructor commits whatever is still pending.
+class AppendLog {
+private:
+    FileHandle file_; // Owned journal file
+    AppendLogOptions options_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<std::byte> pending_; // Records appended since the last commit
+    std::vector<std::promise<void>> waiters_; // One per pending record
+    bool stop_ = false; // Destructor asked the committer to drain and exit
+    std::atomic<std::size_t> commits_{0}; // Batches written and synced so far
+    std::thread committer_; // Declared last so every member above exists before it starts
+
+    void commit_loop() {
+        std::vector<std::byte> batch;
+        std::vector<std::promise<void>> done;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [&] { return stop_ || !pending_.empty(); });
+                if (pending_.empty()) {
+                    return; // Stopped and fully drained
+                }
+                // Optionally give other producers a moment to join this batch
+                cv_.wait_for(lock, options_.max_batch_latency,
+                             [&] { return stop_ || pending_.size() >= options_.max_batch_bytes; });
+                batch.swap(pending_);
+                done.swap(waiters_);
+            }
+            try {
+                file_.write(batch);
+                file_.sync_data();
+                for (auto& waiter : done) {
+                    waiter.set_value();
+                }
+            } catch (...) {
+                for (auto& waiter : done) {
+                    waiter.set_exception(std::current_exception());
+                }
+            }
+            commits_.fetch_add(1, std::memory_order_relaxed);
+            batch.clear();
+            done.clear();
+        }
+    }
+
+public:
+    explicit AppendLog(FileHandle file, AppendLogOptions options = {})
+        : file_(std::move(file)), options_(options) {
+        committer_ = std::thread(&AppendLog::commit_loop, this);
+    }
+
+    ~AppendLog() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        committer_.join(); // Returns once everything appended so far is durable
+    }
+
+    // Pinned in place: the committer thread holds 'this'
+    AppendLog(const AppendLog&) = delete;
+    AppendLog& operator=(const AppendLog&) = delete;
+    AppendLog(AppendLog&&) = delete;
+    AppendLog& operator=(AppendLog&&) = delete;
+
+    // Queue a record for the next group commit; wait on the future for durability
+    std::future<void> append(std::span<const std::byte> record) {
+        std::future<void> durable;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stop_) {
+                throw std::runtime_error("AppendLog is shutting down: " + file_.filename());
+            }
+            pending_.insert(pending_.end(), record.begin(), record.end());
+            durable = waiters_.emplace_back().get_future();
+        }
+        cv_.notify_one();
+        return durable;
+    }
+
+    std::future<void> append(std::string_view record) {
+        return append(std::as_bytes(std::span<const char>(record.data(), record.size())));
+    }
+
+    std::size_t commits() const noexcept {
+        return commits_.load(std::memory_order_relaxed);
+    }
+};
+
+// CRC-32 (IEEE, reflected 0xEDB88320) over a byte range, table built at compile time
+inline constexpr std::array<std::uint32_t, 256> crc32_table = [] {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        table[i] = c;
+    }
+    return table;
+}();
+
+inline std::uint32_t crc32(std::span<const std::byte> bytes) noexcept {
+    std::uint32_t c = 0xFFFFFFFFu;
+    for (const std::byte b : bytes) {
+        c = crc32_table[(c ^ std::to_integer<std::uint32_t>(b)) & 0xFFu] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFu;
+}
+
+// Binary record container written by RecordWriter and read by RecordReader:
+//   header  : magic "FLRC" u32 | version u32
+//   records : length u32 | crc32 u32 | payload[length]            (repeated)
+//   index   : file offset u64 of each record, 8-byte aligned
+//   footer  : index offset u64 | record count u64 | index crc32 u32 | magic "FLRI" u32
+// Integers are stored in host byte order (the kata targets little-endian Linux).
+struct RecordFormat {
+    static constexpr std::uint32_t file_magic = 0x43524C46u; // "FLRC"
+    static constexpr std::uint32_t index_magic = 0x49524C46u; // "FLRI"
+    static constexpr std::uint32_t version = 1;
+    static constexpr std::size_t header_size = 8;
+    static constexpr std::size_t record_header_size = 8;
+    static constexpr std::size_t footer_size = 24;
+};
+
+// Appends length-prefixed, checksummed records to a FileHandle opened for writing from offset 0,
+// then writes the offset index and footer in finish() (or the destructor). Writes go through a
+// FileHandle write buffer, so appending many small records costs few syscalls.
+class RecordWriter {
+private:
+    FileHandle file_;
+    std::vector<std::uint64_t> offsets_; // Start of every record, written out as the index
+    std::uint64_t position_ = 0; // Bytes written so far
+    bool finished_ = false;
+
+    void put(std::span<const std::byte> bytes) {
+        file_.write(bytes);
+        position_ += bytes.size();
+    }
+
+    template <typename T>
+    void put_value(const T& value) {
+        put(std::as_bytes(std::span<const T>(&value, 1)));
+    }
+
+public:
+    explicit RecordWriter(FileHandle file, std::size_t buffer_capacity = std::size_t{4} << 20)
+        : file_(std::move(file)) {
+        file_.enable_write_buffer(buffer_capacity);
+        put_value(RecordFormat::file_magic);
+        put_value(RecordFormat::version);
+    }
+
+    ~RecordWriter() {
+        if (finished_) {
+            return;
+        }
+        try {
+            finish(); // RAII: an unfinished file still gets its index
+        } catch (const std::exception& e) {
+            std::cerr << "RecordWriter: failed to finish " << file_.filename() << ": " << e.what() << "\n";
+        }
+    }
+
+    // Pinned: finish() must run exactly once on the owning object
+    RecordWriter(const RecordWriter&) = delete;
+    RecordWriter& operator=(const RecordWriter&) = delete;
+    RecordWriter(RecordWriter&&) = delete;
+    RecordWriter& operator=(RecordWriter&&) = delete;
+
+    // Returns the index of the new record
+    std::size_t append(std::span<const std::byte> payload) {
+        if (finished_) {
+            throw std::logic_error("RecordWriter already finished: " + file_.filename());
+        }
+        if (payload.size() > UINT32_MAX) {
+            throw std::invalid_argument("Record larger than 4 GB in: " + file_.filename());
+        }
+        offsets_.push_back(position_);
+        put_value(static_cast<std::uint32_t>(payload.size()));
+        put_value(crc32(payload));
+        put(payload);
+        return offsets_.size() - 1;
+    }
+
+    std::size_t append(std::string_view text) {
+        return append(std::as_bytes(std::span<const char>(text.data(), text.size())));
+    }
+
+    // Write the index and footer and flush; no records may be appended afterwards
+    void finish() {
+        if (finished_) {
+            return;
+        }
+        finished_ = true;
+        constexpr std::array<std::byte, 8> padding{};
+        put(std::span(padding).first((8 - position_ % 8) % 8));
+        const std::uint64_t index_offset = position_;
+        const auto index = std::as_bytes(std::span<const std::uint64_t>(offsets_));
+        put(index);
+        put_value(index_offset);
+        put_value(std::uint64_t{offsets_.size()});
+        put_value(crc32(index));
+        put_value(RecordFormat::index_magic);
+        file_.flush();
+    }
+
+    std::size_t size() const noexcept { return offsets_.size(); }
+};
+
+// Random-access reader over a memory-mapped record file: record(i) is one index lookup and
+// returns a span straight into the mapped pages. The mapping is owned by the reader, so it
+// stays valid after the FileHandle it came from is closed.
+class RecordReader {
+private:
+    MappedRegion region_;
+    const std::byte* base_ = nullptr;
+    std::size_t index_offset_ = 0;
+    std::size_t count_ = 0;
+
+    template <typename T>
+    T load(std::size_t offset) const noexcept {
+        T value;
+        std::memcpy(&value, base_ + offset, sizeof(T)); // Unaligned-safe
+        return value;
     }
-    
-    void write(const std::string& data) {
-        if (!is_open_) {
-            throw std::runtime_error("File is not open for writing: " + filename_);
+
+    [[noreturn]] void corrupt(const std::string& what) const {
+        throw std::runtime_error("Corrupt record file (" + what + ")");
+    }
+
+public:
+    explicit RecordReader(FileHandle& file) : region_(file.map(MapMode::ReadOnly, MapAdvice::Random)) {
+        base_ = reinterpret_cast<const std::byte*>(region_.data());
+        const std::size_t size = region_.size();
+        if (size < RecordFormat::header_size + RecordFormat::footer_size ||
+            load<std::uint32_t>(0) != RecordFormat::file_magic) {
+            corrupt("bad header in " + file.filename());
+        }
+        if (load<std::uint32_t>(4) != RecordFormat::version) {
+            corrupt("unsupported version in " + file.filename());
         }
-        file_ << data; // Write data to the file
-        if (!file_) {
-            throw std::runtime_error("Failed to write to file: " + filename_);
+        const std::size_t footer = size - RecordFormat::footer_size;
+        const auto index_offset = load<std::uint64_t>(footer);
+        const auto count = load<std::uint64_t>(footer + 8);
+        if (load<std::uint32_t>(footer + 20) != RecordFormat::index_magic || index_offset > footer ||
+            (footer - index_offset) / 8 != count || (footer - index_offset) % 8 != 0) {
+            corrupt("bad footer in " + file.filename());
+        }
+        index_offset_ = static_cast<std::size_t>(index_offset);
+        count_ = static_cast<std::size_t>(count);
+        if (crc32(std::span<const std::byte>(base_ + index_offset_, count_ * 8)) != load<std::uint32_t>(footer + 16)) {
+            corrupt("index checksum mismatch in " + file.filename());
         }
     }
-    
-    std::string read() {
-        if (!is_open_) {
-            throw std::runtime_error("File is not open for reading: " + filename_);
+
+    std::size_t size() const noexcept { return count_; }
+
+    // O(1) zero-copy access; bounds are checked, the payload checksum is not
+    std::span<const std::byte> record(std::size_t i) const {
+        if (i >= count_) {
+            throw std::out_of_range("Record index " + std::to_string(i) + " out of range");
         }
-        std::string content;
-        std::getline(file_, content, '\0'); // Read the entire file content
-        if (!file_) {
-            throw std::runtime_error("Failed to read from file: " + filename_);
+        const std::size_t offset = load<std::uint64_t>(index_offset_ + i * 8);
+        if (offset + RecordFormat::record_header_size > index_offset_) {
+            corrupt("record " + std::to_string(i) + " offset");
         }
-        return content;
+        const std::size_t length = load<std::uint32_t>(offset);
+        if (offset + RecordFormat::record_header_size + length > index_offset_) {
+            corrupt("record " + std::to_string(i) + " length");
+        }
+        return std::span<const std::byte>(base_ + offset + RecordFormat::record_header_size, length);
+    }
+
+    // record(i) plus a CRC check of the payload
+    std::span<const std::byte> checked_record(std::size_t i) const {
+        const std::span<const std::byte> payload = record(i);
+        const auto offset = static_cast<std::size_t>(payload.data() - base_) - RecordFormat::record_header_size;
+        if (crc32(payload) != load<std::uint32_t>(offset + 4)) {
+            corrupt("record " + std::to_string(i) + " checksum");
+        }
+        return payload;
+    }
+
+    std::string_view text(std::size_t i) const {
+        const std::span<const std::byte> payload = record(i);
+        return std::string_view(reinterpret_cast<const char*>(payload.data()), payload.size());
     }
 };
 
+// Conversion tool: one record per line of a newline-delimited text file. Returns the record count.
+inline std::size_t convert_text_to_records(const std::string& text_path, const std::string& record_path) {
+    FileHandle text(text_path, std::ios::in);
+    const MappedLines lines = text.lines();
+    RecordWriter writer(FileHandle(record_path, std::ios::out));
+    for (std::string_view line : lines) {
+        writer.append(line);
+    }
+    writer.finish();
+    return writer.size();
+}
+
 // Test function
 void test_basic_raii() {
     std::cout << "=== RAII Kata #1: Basic Resource Management ===\n";
@@ -138,7 +2579,397 @@ void test_basic_raii() {
             fh4 = std::move(fh3); // Move assignment
             std::cout << "Move assignment test passed\n";
         }
+
+        // Test 5: Memory-mapped read
+        {
+            FileHandle fh("test1.txt", std::ios::in);
+            MappedRegion region = fh.map(MapMode::ReadOnly, MapAdvice::Sequential);
+            MappedRegion moved = std::move(region); // Ownership of the pages moves too
+            if (moved.view() != "Hello RAII!" || !region.empty()) {
+                throw std::runtime_error("Mapped view does not match file content");
+            }
+            std::cout << "Mapped content: " << moved.view() << std::endl;
+        }
+
+        // Test 6: Writing through a mapping
+        {
+            FileHandle fh("test2.txt", std::ios::in | std::ios::out);
+            MappedRegion region = fh.map(MapMode::ReadWrite);
+            region.data()[0] = 'm'; // "Move test" -> "move test"
+            region.sync();
+        }
+        {
+            FileHandle fh("test2.txt", std::ios::in);
+            if (fh.read() != "move test") {
+                throw std::runtime_error("Write through mapping was not persisted");
+            }
+            std::cout << "Mapped write test passed\n";
+        }
+
+        // Test 7: Empty files read as empty strings instead of throwing
+        {
+            FileHandle fh("test5.txt", std::ios::in | std::ios::out | std::ios::trunc);
+            if (!fh.read().empty()) {
+                throw std::runtime_error("Empty file did not read as empty");
+            }
+            std::cout << "Empty file read test passed\n";
+        }
+
+        // Test 8: read_into reuses a caller-owned buffer
+        {
+            std::array<char, 64> buffer{};
+            FileHandle fh("test1.txt", std::ios::in);
+            const std::size_t n = fh.read_into(buffer);
+            if (std::string_view(buffer.data(), n) != "Hello RAII!") {
+                throw std::runtime_error("read_into returned wrong content");
+            }
+            std::cout << "read_into content: " << std::string_view(buffer.data(), n) << std::endl;
+        }
+
+        // Test 9: Chunked streaming with read-ahead
+        {
+            std::string expected;
+            for (int i = 0; i < 1000; ++i) {
+                expected += "line " + std::to_string(i) + "\n";
+            }
+            {
+                FileHandle fh("test6.txt", std::ios::out);
+                fh.write(expected);
+            }
+            FileHandle fh("test6.txt", std::ios::in);
+            std::string streamed;
+            std::size_t count = 0;
+            for (std::span<const char> chunk : fh.chunks(1024)) {
+                streamed.append(chunk.data(), chunk.size());
+                ++count;
+            }
+            if (streamed != expected) {
+                throw std::runtime_error("Chunked read does not match file content");
+            }
+            std::cout << "Chunked read test passed (" << count << " chunks)\n";
+        }
+
+        // Test 10: Stopping chunk iteration early joins the reader thread
+        {
+            FileHandle fh("test6.txt", std::ios::in);
+            for (std::span<const char> chunk : fh.chunks(64)) {
+                if (chunk.size() != 64) {
+                    throw std::runtime_error("Unexpected first chunk size");
+                }
+                break; // ChunkReader destructor stops the read-ahead
+            }
+            std::cout << "Early chunk exit test passed\n";
+        }
+
+        // Test 11: Line iteration handles CRLF and a final line without a newline
+        {
+            {
+                FileHandle fh("test7.txt", std::ios::out);
+                fh.write("alpha\r\nbeta\n\na line long enough to cross a 32-byte vector block\ngamma");
+            }
+            FileHandle fh("test7.txt", std::ios::in);
+            const MappedLines file_lines = fh.lines(); // Views below point into this mapping
+            std::vector<std::string_view> lines;
+            for (std::string_view line : file_lines) {
+                lines.push_back(line);
+            }
+            const std::vector<std::string_view> expected = {
+                "alpha", "beta", "", "a line long enough to cross a 32-byte vector block", "gamma"};
+            if (lines != expected) {
+                throw std::runtime_error("Line iteration returned wrong lines");
+            }
+            for (const NewlineFinder finder : {&find_newline_scalar, newline_finder()}) {
+                std::size_t count = 0;
+                for (std::string_view line : LineRange("x\ny\n", finder)) {
+                    count += line.size();
+                }
+                if (count != 2) {
+                    throw std::runtime_error("Newline kernels disagree");
+                }
+            }
+            std::cout << "Line iteration test passed (" << lines.size() << " lines)\n";
+        }
+
+        // Test 12: Buffered writes are combined and flushed on threshold and on close
+        {
+            {
+                FileHandle fh("test8.txt", std::ios::out);
+                BufferedWriter& writer = fh.enable_write_buffer(16);
+                fh.write("0123456789");
+                fh.write(std::as_bytes(std::span<const char>("abcdef", 6))); // Fills the buffer -> flush
+                fh.write("tail");
+                if (writer.syscalls() != 1 || writer.buffered() != 4) {
+                    throw std::runtime_error("Write buffer did not flush on threshold");
+                }
+            } // Destructor flushes "tail"
+            FileHandle fh("test8.txt", std::ios::in);
+            if (fh.read() != "0123456789abcdeftail") {
+                throw std::runtime_error("Buffered writes were lost");
+            }
+            std::cout << "Buffered writer test passed\n";
+        }
+
+        // Test 13: Scatter-gather record I/O with writev/readv
+        {
+            struct RecordHeader {
+                std::uint32_t magic;
+                std::uint32_t length;
+            };
+            const RecordHeader header{0xF1EE7u, 7};
+            const std::string payload = "payload";
+            const std::uint32_t trailer = 0xC0FFEEu;
+            {
+                FileHandle fh("test9.bin", std::ios::out);
+                fh.write_vec({std::as_bytes(std::span(&header, 1)),
+                              std::as_bytes(std::span<const char>(payload.data(), payload.size())),
+                              std::as_bytes(std::span(&trailer, 1))});
+            }
+            RecordHeader read_header{};
+            std::array<char, 7> read_payload{};
+            std::uint32_t read_trailer = 0;
+            FileHandle fh("test9.bin", std::ios::in);
+            const std::size_t n = fh.read_vec({std::as_writable_bytes(std::span(&read_header, 1)),
+                                               std::as_writable_bytes(std::span(read_payload)),
+                                               std::as_writable_bytes(std::span(&read_trailer, 1))});
+            if (n != sizeof(header) + payload.size() + sizeof(trailer) || read_header.magic != header.magic ||
+                std::string_view(read_payload.data(), read_payload.size()) != payload || read_trailer != trailer) {
+                throw std::runtime_error("Vectored record round trip failed");
+            }
+            std::cout << "Vectored I/O test passed (" << n << " bytes)\n";
+        }
+
+        // Test 14: Group-commit append log from several producer threads
+        {
+            std::size_t commits = 0;
+            {
+                AppendLog log(FileHandle("test10.log", std::ios::out));
+                std::vector<std::thread> producers;
+                for (int t = 0; t < 4; ++t) {
+                    producers.emplace_back([&log, t] {
+                        for (int i = 0; i < 50; ++i) {
+                            log.append("r" + std::to_string(t) + "-" + std::to_string(i) + "\n").get(); // Durable here
+                        }
+                    });
+                }
+                for (auto& producer : producers) {
+                    producer.join();
+                }
+                commits = log.commits();
+            }
+            FileHandle fh("test10.log", std::ios::in);
+            const MappedLines records = fh.lines();
+            std::size_t count = 0;
+            for (std::string_view record : records) {
+                if (!record.empty()) {
+                    ++count;
+                }
+            }
+            if (count != 200) {
+                throw std::runtime_error("AppendLog lost records");
+            }
+            std::cout << "Append log test passed (" << count << " records in " << commits << " commits)\n";
+        }
+
+        // Test 15: Async read/write through the best available engine
+        {
+            const auto engine = make_async_io_engine();
+            std::array<char, 5> buffer{};
+            std::future<std::size_t> pending;
+            {
+                FileHandle fh("test11.txt", std::ios::in | std::ios::out | std::ios::trunc);
+                const std::string text = "async hello";
+                if (fh.async_write(*engine, std::as_bytes(std::span<const char>(text.data(), text.size())), 0).get() != text.size()) {
+                    throw std::runtime_error("Short async write");
+                }
+                pending = fh.async_read(*engine, buffer, 6);
+            } // Closing waits for the read still in flight
+            if (pending.get() != buffer.size() || std::string_view(buffer.data(), buffer.size()) != "hello") {
+                throw std::runtime_error("Async read returned wrong data");
+            }
+            std::cout << "Async I/O test passed (" << engine->name() << ")\n";
+        }
+
+        // Test 16: LRU handle cache with leases, eviction and invalidation
+        {
+            FileHandleCache cache(2);
+            {
+                auto lease = cache.acquire("test1.txt");
+                if (lease->read() != "Hello RAII!") {
+                    throw std::runtime_error("Cached handle read wrong content");
+                }
+            }
+            {
+                auto lease = cache.acquire("test1.txt"); // Hit, rewound to the start
+                if (lease->read() != "Hello RAII!") {
+                    throw std::runtime_error("Reused handle was not rewound");
+                }
+            }
+            {
+                auto second = cache.acquire("test2.txt");
+                auto third = cache.acquire("test3.txt"); // Three open with max 2: evicts idle test1.txt
+            }
+            cache.invalidate("test2.txt");
+            const FileHandleCache::Stats stats = cache.stats();
+            if (stats.hits != 1 || stats.misses != 3 || stats.evictions != 1 || stats.open != 1) {
+                throw std::runtime_error("FileHandleCache counters are wrong");
+            }
+
+            FileHandleCache writers(1);
+            {
+                auto lease = writers.acquire("test15.txt", std::ios::out);
+                lease->write("A much longer first payload");
+            }
+            {
+                auto lease = writers.acquire("test15.txt", std::ios::out); // Hit: truncated like a fresh open
+                lease->write("short");
+            }
+            if (writers.stats().hits != 1 || FileHandle("test15.txt", std::ios::in).read() != "short") {
+                throw std::runtime_error("Reused write handle kept stale bytes");
+            }
+
+            std::ostringstream captured; // Pooled handles are never moved, so no FileHandle trace per cycle
+            {
+                struct RestoreCout {
+                    std::streambuf* saved;
+                    ~RestoreCout() { std::cout.rdbuf(saved); }
+                } restore{std::cout.rdbuf(captured.rdbuf())};
+                for (int i = 0; i < 2; ++i) { // A miss, then a hit
+                    auto lease = cache.acquire("test1.txt");
+                    lease->read();
+                }
+            }
+            if (!captured.str().empty()) {
+                throw std::runtime_error("Cached acquire/return wrote to stdout: " + captured.str());
+            }
+            std::cout << "Handle cache test passed (" << stats.hits << " hit, " << stats.misses << " misses)\n";
+        }
         
+        // Test 17: Zero-copy file copy and file-to-pipe transfer
+        {
+            FileHandle source("test1.txt", std::ios::in);
+            FileHandle copy("test12.txt", std::ios::out);
+            const FileHandle::CopyResult result = source.copy_to(copy);
+            if (result.bytes != 11 || FileHandle("test12.txt", std::ios::in).read() != "Hello RAII!") {
+                throw std::runtime_error("copy_to produced a wrong copy");
+            }
+
+            std::array<int, 2> pipe_fds{};
+            if (::pipe(pipe_fds.data()) != 0) {
+                throw std::runtime_error("Failed to create pipe");
+            }
+            source.seek(0);
+            const FileHandle::CopyResult piped = source.transfer_to(pipe_fds[1]);
+            std::array<char, 16> buffer{};
+            const ssize_t n = ::read(pipe_fds[0], buffer.data(), buffer.size());
+            ::close(pipe_fds[0]);
+            ::close(pipe_fds[1]);
+            if (piped.bytes != 11 || n != 11 || std::string_view(buffer.data(), 11) != "Hello RAII!") {
+                throw std::runtime_error("transfer_to produced wrong pipe content");
+            }
+            std::cout << "Zero-copy test passed (" << FileHandle::method_name(result.method) << ", "
+                      << FileHandle::method_name(piped.method) << ")\n";
+        }
+
+        // Test 18: Binary record container round trip and the text conversion tool
+        {
+            {
+                RecordWriter writer(FileHandle("test13.rec", std::ios::out));
+                writer.append("first");
+                writer.append(std::string(1000, 'x'));
+                writer.append("");
+            } // Destructor writes the index
+            FileHandle fh("test13.rec", std::ios::in);
+            const RecordReader reader(fh);
+            if (reader.size() != 3 || reader.text(0) != "first" || reader.checked_record(1).size() != 1000 ||
+                !reader.record(2).empty()) {
+                throw std::runtime_error("Record round trip failed");
+            }
+            const std::size_t converted = convert_text_to_records("test7.txt", "test14.rec");
+            FileHandle converted_fh("test14.rec", std::ios::in);
+            if (converted != 5 || RecordReader(converted_fh).text(4) != "gamma") {
+                throw std::runtime_error("Text conversion failed");
+            }
+            std::cout << "Record container test passed (" << reader.size() << " records)\n";
+        }
+
+        // Test 19: Compressed stream mode - round trip, block seeks, parallel decode, corruption
+        {
+            std::string expected;
+            for (int i = 0; i < 400; ++i) {
+                expected += "level=info request=" + std::to_string(i % 17) + " status=200\n";
+            }
+            std::mt19937 rng(19);
+            for (int i = 0; i < 5000; ++i) {
+                expected += static_cast<char>(rng()); // Incompressible tail, stored raw
+            }
+            {
+                FileHandle fh("test15.lz", std::ios::out);
+                fh.enable_compression(4096);
+                fh.write(expected.substr(0, 10000));
+                fh.write(expected.substr(10000));
+            } // Destructor writes the final short block
+            FileHandle fh("test15.lz", std::ios::in);
+            const CompressedFileReader reader = fh.compressed_reader();
+            if (reader.raw_size() != expected.size() || reader.read_all(3) != expected) {
+                throw std::runtime_error("Compressed round trip failed");
+            }
+            const std::size_t k = reader.block_containing(9000);
+            std::vector<std::byte> block(reader.block_raw_size(k));
+            reader.decompress_block(k, block);
+            if (k != 2 || reader.block_raw_offset(k) != 8192 ||
+                std::memcmp(block.data(), expected.data() + 8192, block.size()) != 0) {
+                throw std::runtime_error("Compressed block seek failed");
+            }
+            const std::size_t stored = fh.read().size();
+            std::vector<std::byte> garbage(100, std::byte{0xF0}); // Literal runs pointing past the input
+            bool rejected = false;
+            try {
+                LzCodec::decompress(garbage, block);
+            } catch (const std::runtime_error&) {
+                rejected = true;
+            }
+            if (!rejected) {
+                throw std::runtime_error("Corrupt compressed block was accepted");
+            }
+            std::cout << "Compressed stream test passed (" << reader.block_count() << " blocks, " << expected.size()
+                      << " -> " << stored << " bytes)\n";
+        }
+
+        // Test 20: Direct I/O with aligned buffers (or the buffered fallback)
+        {
+            FileHandle fh("test16.bin", std::ios::in | std::ios::out | std::ios::trunc);
+            const bool direct = fh.enable_direct_io();
+            AlignedBuffer out(8192, std::max<std::size_t>(fh.io_alignment(), 4096));
+            for (std::size_t i = 0; i < out.size(); ++i) {
+                out.data()[i] = static_cast<std::byte>(i % 251);
+            }
+            fh.write_direct(out.span().first(out.size() - 100), 0); // Unaligned tail goes through the page cache
+            AlignedBuffer in(out.size(), out.alignment());
+            const std::size_t n = fh.read_direct(in.span(), 0);
+            if (n != out.size() - 100 || std::memcmp(in.data(), out.data(), n) != 0) {
+                throw std::runtime_error("Direct I/O round trip failed");
+            }
+            bool rejected = !direct; // Alignment is only enforced in direct mode
+            try {
+                fh.read_direct(in.span().subspan(1, 512), 0);
+            } catch (const std::invalid_argument&) {
+                rejected = true;
+            }
+            if (!rejected) {
+                throw std::runtime_error("Unaligned direct read was accepted");
+            }
+            bool zero_rejected = false;
+            try {
+                AlignedBuffer invalid(4096, 0);
+            } catch (const std::invalid_argument&) {
+                zero_rejected = true;
+            }
+            if (!zero_rejected) {
+                throw std::runtime_error("Zero buffer alignment was accepted");
+            }
+            std::cout << "Direct I/O test passed (" << (direct ? "O_DIRECT, " + std::to_string(fh.io_alignment()) + "-byte alignment" : std::string("buffered fallback")) << ")\n";
+        }
+
         std::cout << "All tests passed!\n";
         
     } catch (const std::exception& e) {
@@ -146,7 +2977,567 @@ void test_basic_raii() {
     }
 }
 
-int main() {
+// Benchmark helpers - fold every byte so the compiler cannot skip the reads
+std::uint64_t checksum(std::string_view bytes) {
+    std::uint64_t sum = 0;
+    for (const char c : bytes) {
+        sum += static_cast<unsigned char>(c);
+    }
+    return sum;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Create a benchmark file of 'size' bytes, written in 1 MB blocks
+void make_bench_file(const std::string& filename, std::size_t size) {
+    const std::string block(std::size_t{1} << 20, 'x');
+    FileHandle fh(filename, std::ios::out | std::ios::binary);
+    for (std::size_t written = 0; written < size; written += block.size()) {
+        fh.write(block.substr(0, std::min(block.size(), size - written)));
+    }
+}
+
+// Share of a file's pages currently in the page cache (mincore over a mapping of it)
+double resident_fraction(const std::string& filename) {
+    FileHandle fh(filename, std::ios::in);
+    const MappedRegion region = fh.map();
+    if (region.empty()) {
+        return 0.0;
+    }
+    const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    std::vector<unsigned char> pages((region.size() + page - 1) / page);
+    if (::mincore(const_cast<char*>(region.data()), region.size(), pages.data()) != 0) {
+        throw std::runtime_error(std::string("mincore failed: ") + std::strerror(errno));
+    }
+    const auto resident = std::count_if(pages.begin(), pages.end(), [](unsigned char p) { return (p & 1) != 0; });
+    return static_cast<double>(resident) / static_cast<double>(pages.size());
+}
+
+// Evict a file's (clean) pages so the next read starts cold
+void drop_page_cache(const std::string& filename) {
+    FileHandle fh(filename, std::ios::in);
+    fh.sync_data();
+    ::posix_fadvise(fh.native_handle(), 0, 0, POSIX_FADV_DONTNEED);
+}
+
+// Compare read() (a sized bulk ::read of the whole file into a std::string, i.e. a copy out of the
+// page cache) with map() (a view over the page cache), each followed by a checksum pass
+void benchmark_map_vs_read(std::size_t max_mb) {
+    std::cout << "\n--- Benchmark: read() vs map() ---\n";
+    const std::string filename = "bench_map.bin";
+    for (std::size_t mb = 1; mb <= max_mb; mb *= 4) {
+        const std::size_t size = mb << 20;
+        make_bench_file(filename, size);
+
+        auto start = std::chrono::steady_clock::now();
+        std::uint64_t read_sum = 0;
+        {
+            FileHandle fh(filename, std::ios::in | std::ios::binary);
+            read_sum = checksum(fh.read());
+        }
+        const double read_s = seconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        std::uint64_t map_sum = 0;
+        {
+            FileHandle fh(filename, std::ios::in | std::ios::binary);
+            MappedRegion region = fh.map(MapMode::ReadOnly, MapAdvice::Sequential);
+            map_sum = checksum(region.view());
+        }
+        const double map_s = seconds_since(start);
+
+        if (read_sum != map_sum) {
+            throw std::runtime_error("Benchmark checksum mismatch");
+        }
+        const double mbs = static_cast<double>(mb);
+        std::cout << mb << " MB: read() " << mbs / read_s << " MB/s, map() " << mbs / map_s << " MB/s\n";
+    }
+    std::remove(filename.c_str());
+}
+
+// Split newline-delimited telemetry with std::getline vs LineRange over a mapping, in GB/s
+void benchmark_lines(std::size_t max_mb) {
+    std::cout << "\n--- Benchmark: std::getline vs lines() ---\n";
+    const std::string filename = "bench_lines.txt";
+    const std::size_t size = std::min<std::size_t>(max_mb, 256) << 20;
+    {
+        FileHandle fh(filename, std::ios::out);
+        std::string block;
+        for (int i = 0; block.size() < (std::size_t{1} << 20); ++i) {
+            block += "t=" + std::to_string(i) + ",robot=" + std::to_string(i % 64) + ",x=12.5,y=-3.25,theta=0.785\n";
+        }
+        for (std::size_t written = 0; written < size; written += block.size()) {
+            fh.write(block);
+        }
+    }
+
+    const auto report = [](const char* name, std::size_t bytes, std::size_t count, double s) {
+        std::cout << name << ": " << static_cast<double>(bytes) / s / 1e9 << " GB/s (" << count << " lines)\n";
+    };
+
+    FileHandle fh(filename, std::ios::in);
+    const MappedRegion region = fh.map(MapMode::ReadOnly, MapAdvice::WillNeed);
+    const std::string text(region.view()); // Both sides split the same in-memory text
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t count = 0;
+    std::size_t bytes = 0;
+    {
+        std::istringstream stream(text);
+        std::string line;
+        while (std::getline(stream, line)) {
+            ++count;
+            bytes += line.size();
+        }
+    }
+    report("std::getline", text.size(), count, seconds_since(start));
+    const std::size_t expected = bytes;
+
+    const std::pair<const char*, NewlineFinder> kernels[] = {
+        {"lines() scalar", &find_newline_scalar},
+#if defined(__x86_64__) || defined(__i386__)
+        {"lines() sse2", &find_newline_sse2},
+        {"lines() avx2", __builtin_cpu_supports("avx2") ? &find_newline_avx2 : nullptr}, // Not an SSE2 rerun
+#endif
+    };
+    for (const auto& [name, finder] : kernels) {
+        if (!finder) {
+            std::cout << name << ": (unsupported on this CPU)\n";
+            continue;
+        }
+        start = std::chrono::steady_clock::now();
+        count = 0;
+        bytes = 0;
+        for (std::string_view line : LineRange(text, finder)) {
+            ++count;
+            bytes += line.size();
+        }
+        if (bytes != expected) {
+            throw std::runtime_error("Benchmark line split mismatch");
+        }
+        report(name, text.size(), count, seconds_since(start));
+    }
+    std::remove(filename.c_str());
+}
+
+// Small formatted records written one write(2) each vs through BufferedWriter
+void benchmark_buffered_writes(std::size_t max_mb) {
+    std::cout << "\n--- Benchmark: write() vs BufferedWriter ---\n";
+    const std::string filename = "bench_write.log";
+    const std::size_t size = std::min<std::size_t>(max_mb, 64) << 20;
+    std::vector<std::string> records;
+    for (int i = 0; i < 1024; ++i) {
+        records.push_back("t=" + std::to_string(i) + " robot=" + std::to_string(i % 64) + " reward=0.25 done=0\n");
+    }
+
+    for (const std::size_t capacity : {std::size_t{0}, std::size_t{1} << 20, std::size_t{4} << 20, std::size_t{16} << 20}) {
+        std::size_t bytes = 0;
+        std::size_t count = 0;
+        std::size_t syscalls = 0;
+        const auto start = std::chrono::steady_clock::now();
+        {
+            FileHandle fh(filename, std::ios::out);
+            BufferedWriter* writer = capacity ? &fh.enable_write_buffer(capacity) : nullptr;
+            for (; bytes < size; ++count) {
+                const std::string& record = records[count % records.size()];
+                fh.write(record);
+                bytes += record.size();
+            }
+            fh.flush();
+            syscalls = writer ? writer->syscalls() : count; // Unbuffered: one write(2) per record
+        }
+        const double s = seconds_since(start);
+        const double mb = static_cast<double>(bytes) / (1 << 20);
+        std::cout << (capacity ? std::to_string(capacity >> 20) + " MB buffer" : std::string("unbuffered"))
+                  << ": " << mb / s << " MB/s, " << static_cast<double>(syscalls) / mb << " syscalls/MB\n";
+    }
+    std::remove(filename.c_str());
+}
+
+// Durable appends from several threads: write + fdatasync per record vs AppendLog group commit
+void benchmark_append_log() {
+    std::cout << "\n--- Benchmark: per-record fdatasync vs AppendLog ---\n";
+    const std::string filename = "bench_journal.log";
+    constexpr int threads = 8;
+    constexpr int records_per_thread = 250;
+    const std::string record(128, 'j');
+
+    const auto run = [&](const char* name, auto&& append_durably) {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> producers;
+        for (int t = 0; t < threads; ++t) {
+            producers.emplace_back([&] {
+                for (int i = 0; i < records_per_thread; ++i) {
+                    append_durably();
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        std::cout << name << ": " << threads * records_per_thread / seconds_since(start) << " records/s\n";
+    };
+
+    {
+        FileHandle fh(filename, std::ios::out);
+        std::mutex mutex;
+        run("per-record fdatasync", [&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            fh.write(record);
+            fh.sync_data();
+        });
+    }
+    for (const auto latency : {std::chrono::microseconds{0}, std::chrono::microseconds{500}}) {
+        AppendLog log(FileHandle(filename, std::ios::out), AppendLogOptions{latency, std::size_t{1} << 20});
+        const std::string name = "AppendLog group commit (" + std::to_string(latency.count()) + " us latency)";
+        run(name.c_str(), [&] { log.append(record).get(); });
+        std::cout << "  (" << log.commits() << " commits for " << threads * records_per_thread << " records)\n";
+    }
+    std::remove(filename.c_str());
+}
+
+// Random 4 KB reads kept 'queue depth' deep through each async engine
+void benchmark_async_reads(std::size_t max_mb) {
+    std::cout << "\n--- Benchmark: async random reads by queue depth ---\n";
+    const std::string filename = "bench_async.bin";
+    const std::size_t size = std::min<std::size_t>(max_mb, 256) << 20;
+    make_bench_file(filename, size);
+
+    constexpr std::size_t block = 4096;
+    constexpr std::size_t ops = 32768;
+    std::vector<std::unique_ptr<AsyncIoEngine>> engines;
+    try {
+        engines.push_back(std::make_unique<IoUringEngine>(256));
+    } catch (const std::runtime_error& e) {
+        std::cout << "io_uring unavailable: " << e.what() << "\n";
+    }
+    engines.push_back(std::make_unique<ThreadPoolIoEngine>(8));
+
+    FileHandle fh(filename, std::ios::in);
+    for (const auto& engine : engines) {
+        for (const std::size_t depth : {std::size_t{1}, std::size_t{8}, std::size_t{64}, std::size_t{256}}) {
+            std::mt19937_64 rng(42);
+            std::uniform_int_distribution<std::size_t> pick(0, size / block - 1);
+            std::vector<std::array<char, block>> buffers(depth);
+            std::vector<std::future<std::size_t>> slots(depth);
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < ops; ++i) {
+                const std::size_t slot = i % depth;
+                if (slots[slot].valid()) {
+                    slots[slot].get(); // Oldest request in this slot must finish before its buffer is reused
+                }
+                slots[slot] = fh.async_read(*engine, buffers[slot], static_cast<off_t>(pick(rng) * block));
+            }
+            for (auto& pending : slots) {
+                if (pending.valid()) {
+                    pending.get();
+                }
+            }
+            const double s = seconds_since(start);
+            std::cout << engine->name() << " QD " << depth << ": " << static_cast<double>(ops) / s << " IOPS, "
+                      << static_cast<double>(ops * block) / s / (1 << 20) << " MB/s\n";
+        }
+    }
+    std::remove(filename.c_str());
+}
+
+// Open + read + close per request vs leasing pooled handles from FileHandleCache
+void benchmark_handle_cache() {
+    std::cout << "\n--- Benchmark: open/close vs FileHandleCache ---\n";
+    constexpr std::size_t tiles = 256;
+    constexpr std::size_t requests = 100000;
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < tiles; ++i) {
+        names.push_back("bench_tile_" + std::to_string(i) + ".bin");
+        FileHandle fh(names.back(), std::ios::out);
+        fh.write(std::string(4096, 't'));
+    }
+
+    std::array<char, 4096> buffer{};
+    const auto run = [&](const char* name, auto&& read_tile) {
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<std::size_t> pick(0, tiles - 1);
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < requests; ++i) {
+            read_tile(names[pick(rng)]);
+        }
+        std::cout << name << ": " << static_cast<double>(requests) / seconds_since(start) << " opens/s\n";
+    };
+
+    run("open/close", [&](const std::string& tile) {
+        FileHandle fh(tile, std::ios::in);
+        fh.read_into(buffer);
+    });
+    for (const std::size_t max_open : {tiles, tiles / 4}) {
+        FileHandleCache cache(max_open);
+        const std::string name = "FileHandleCache (max " + std::to_string(max_open) + " fds)";
+        run(name.c_str(), [&](const std::string& tile) {
+            auto lease = cache.acquire(tile);
+            lease->read_into(buffer);
+        });
+        const FileHandleCache::Stats stats = cache.stats();
+        std::cout << "  hits " << stats.hits << ", misses " << stats.misses << ", evictions " << stats.evictions << "\n";
+    }
+    for (const auto& tile : names) {
+        std::remove(tile.c_str());
+    }
+}
+
+// Run 'work' in a forked child and return {seconds, peak RSS in MB} for it alone
+template <typename Work>
+std::pair<double, double> measure_in_child(Work&& work) {
+    const auto start = std::chrono::steady_clock::now();
+    const pid_t pid = ::fork();
+    if (pid < 0) {
+        throw std::runtime_error(std::string("fork failed: ") + std::strerror(errno));
+    }
+    if (pid == 0) {
+        try {
+            work();
+        } catch (const std::exception& e) {
+            std::cerr << "Benchmark child failed: " << e.what() << "\n";
+            ::_exit(1);
+        }
+        ::_exit(0);
+    }
+    int status = 0;
+    struct rusage usage {};
+    ::wait4(pid, &status, 0, &usage);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        throw std::runtime_error("Benchmark child failed");
+    }
+    return {seconds_since(start), static_cast<double>(usage.ru_maxrss) / 1024.0};
+}
+
+// read() + write() through a std::string vs copy_to(), throughput and peak RSS of each
+void benchmark_copy(std::size_t max_mb) {
+    std::cout << "\n--- Benchmark: read()+write() vs copy_to() ---\n";
+    const std::string source = "bench_copy_src.bin";
+    const std::string target = "bench_copy_dst.bin";
+    const std::size_t mb = std::min<std::size_t>(max_mb, 1024);
+    make_bench_file(source, mb << 20);
+
+    const auto [copy_s, copy_rss] = measure_in_child([&] {
+        FileHandle in(source, std::ios::in);
+        FileHandle out(target, std::ios::out);
+        in.copy_to(out);
+    });
+    const auto [rw_s, rw_rss] = measure_in_child([&] {
+        FileHandle in(source, std::ios::in);
+        FileHandle out(target, std::ios::out);
+        out.write(in.read());
+    });
+    const double mbs = static_cast<double>(mb);
+    std::cout << mb << " MB: read()+write() " << mbs / rw_s << " MB/s, peak RSS " << rw_rss << " MB\n";
+    std::cout << mb << " MB: copy_to() " << mbs / copy_s << " MB/s, peak RSS " << copy_rss << " MB\n";
+    std::remove(source.c_str());
+    std::remove(target.c_str());
+}
+
+// One telemetry sample, as parsed from text or stored raw in a binary record
+struct TelemetrySample {
+    std::int64_t t;
+    std::int64_t robot;
+    double x;
+    double y;
+    double theta;
+};
+
+// Parse "t=<int>,robot=<int>,x=<f>,y=<f>,theta=<f>"
+TelemetrySample parse_telemetry(std::string_view line) {
+    TelemetrySample sample{};
+    const auto field = [&](std::string_view name, auto& value) {
+        const std::size_t key = line.find(name);
+        const std::size_t start = key + name.size() + 1; // Skip "name="
+        std::from_chars(line.data() + start, line.data() + line.size(), value);
+    };
+    field("t", sample.t);
+    field("robot", sample.robot);
+    field("x", sample.x);
+    field("y", sample.y);
+    field("theta", sample.theta);
+    return sample;
+}
+
+// Replay telemetry by parsing text lines vs reading binary records through RecordReader
+void benchmark_record_replay(std::size_t max_mb) {
+    std::cout << "\n--- Benchmark: text parsing vs binary record replay ---\n";
+    const std::string text_file = "bench_replay.txt";
+    const std::string record_file = "bench_replay.rec";
+    const std::size_t size = std::min<std::size_t>(max_mb, 256) << 20;
+    {
+        FileHandle text(text_file, std::ios::out);
+        text.enable_write_buffer();
+        RecordWriter records(FileHandle(record_file, std::ios::out));
+        std::size_t written = 0;
+        for (std::int64_t i = 0; written < size; ++i) {
+            const TelemetrySample sample{i, i % 64, 0.5 * static_cast<double>(i % 1000), -0.25 * static_cast<double>(i % 77), 0.001 * static_cast<double>(i % 6283)};
+            const std::string line = "t=" + std::to_string(sample.t) + ",robot=" + std::to_string(sample.robot) +
+                                     ",x=" + std::to_string(sample.x) + ",y=" + std::to_string(sample.y) +
+                                     ",theta=" + std::to_string(sample.theta) + "\n";
+            text.write(line);
+            records.append(std::as_bytes(std::span<const TelemetrySample>(&sample, 1)));
+            written += line.size();
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    double text_sum = 0.0;
+    std::size_t count = 0;
+    {
+        FileHandle fh(text_file, std::ios::in);
+        std::istringstream stream(fh.read());
+        std::string line;
+        while (std::getline(stream, line)) {
+            const TelemetrySample sample = parse_telemetry(line);
+            text_sum += sample.x + sample.y + sample.theta;
+            ++count;
+        }
+    }
+    const double text_s = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    double record_sum = 0.0;
+    {
+        FileHandle fh(record_file, std::ios::in);
+        const RecordReader reader(fh);
+        for (std::size_t i = 0; i < reader.size(); ++i) {
+            TelemetrySample sample{};
+            std::memcpy(&sample, reader.record(i).data(), sizeof(sample));
+            record_sum += sample.x + sample.y + sample.theta;
+        }
+    }
+    const double record_s = seconds_since(start);
+
+    if (std::abs(text_sum - record_sum) > 1e-3 * std::abs(record_sum) + 1.0) {
+        throw std::runtime_error("Replay results differ");
+    }
+    const double n = static_cast<double>(count);
+    std::cout << "text parsing: " << n / text_s / 1e6 << " M samples/s\n";
+    std::cout << "binary records: " << n / record_s / 1e6 << " M samples/s\n";
+    std::remove(text_file.c_str());
+    std::remove(record_file.c_str());
+}
+
+// Block compression of log-like text: single-threaded compression through FileHandle's compressed
+// mode, then decompression with 1 and several threads
+void benchmark_compression(std::size_t max_mb) {
+    std::cout << "\n--- Benchmark: LZ block compression of log data (64 KB blocks) ---\n";
+    const std::string filename = "bench_compress.lz";
+    const std::size_t size = std::min<std::size_t>(max_mb, 256) << 20;
+    std::string text;
+    text.reserve(size + 256);
+    std::mt19937 rng(12);
+    static constexpr std::array<std::string_view, 4> levels{"INFO", "DEBUG", "WARN", "ERROR"};
+    for (std::uint64_t i = 0; text.size() < size; ++i) {
+        text += "2024-05-01T12:" + std::to_string(10 + i / 60000 % 50) + ":" + std::to_string(10 + i / 1000 % 50) +
+                "." + std::to_string(i % 1000) + " " + std::string(levels[rng() % levels.size()]) +
+                " worker-" + std::to_string(rng() % 16) + " request_id=" + std::to_string(rng()) +
+                " path=/api/v1/items/" + std::to_string(rng() % 5000) + " latency_ms=" + std::to_string(rng() % 250) + "\n";
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t stored = 0;
+    {
+        FileHandle fh(filename, std::ios::out);
+        fh.enable_write_buffer();
+        BlockCompressor& compressor = fh.enable_compression();
+        fh.write(text);
+        fh.flush();
+        stored = compressor.stored_bytes();
+    }
+    const double compress_s = seconds_since(start);
+    const double mb = static_cast<double>(text.size()) / (1 << 20);
+    std::cout << "compress: " << mb / compress_s << " MB/s, ratio "
+              << static_cast<double>(text.size()) / static_cast<double>(stored) << "\n";
+
+    FileHandle fh(filename, std::ios::in);
+    const CompressedFileReader reader = fh.compressed_reader();
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    for (const unsigned threads : {1u, std::min(cores, 8u)}) {
+        start = std::chrono::steady_clock::now();
+        const std::string restored = reader.read_all(threads);
+        const double decompress_s = seconds_since(start);
+        if (restored != text) {
+            throw std::runtime_error("Decompressed data differs");
+        }
+        std::cout << "decompress x" << threads << ": " << mb / decompress_s << " MB/s\n";
+        if (cores == 1) {
+            break; // Nothing to parallelize over
+        }
+    }
+    std::remove(filename.c_str());
+}
+
+// Cold sequential scan with 1 MB reads, through the page cache and with O_DIRECT: throughput and
+// how much of the file is left occupying the page cache afterwards
+void benchmark_direct_io(std::size_t max_mb) {
+    std::cout << "\n--- Benchmark: buffered vs O_DIRECT sequential scan (cold cache) ---\n";
+    const std::string filename = "bench_direct.bin";
+    const std::size_t size = std::min<std::size_t>(max_mb, 1024) << 20;
+    make_bench_file(filename, size);
+    for (const bool direct : {false, true}) {
+        drop_page_cache(filename);
+        FileHandle fh(filename, std::ios::in);
+        const bool active = direct && fh.enable_direct_io();
+        AlignedBuffer buffer(std::size_t{1} << 20, std::max<std::size_t>(fh.io_alignment(), 4096));
+        std::uint64_t sum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (off_t offset = 0;;) {
+            const std::size_t n = fh.read_direct(buffer.span(), offset);
+            sum += checksum(std::string_view(reinterpret_cast<const char*>(buffer.data()), n));
+            offset += static_cast<off_t>(n);
+            if (n < buffer.size()) {
+                break;
+            }
+        }
+        const double s = seconds_since(start);
+        std::cout << (direct ? (active ? "O_DIRECT: " : "O_DIRECT (unsupported, buffered): ") : "buffered: ")
+                  << static_cast<double>(size) / (1 << 20) / s << " MB/s, " << 100.0 * resident_fraction(filename)
+                  << "% of the file left in page cache (checksum " << sum % 1000 << ")\n";
+    }
+    std::remove(filename.c_str());
+}
+
+void run_benchmarks(std::size_t max_mb) {
+    std::cout << "=== RAII Kata #1: FileHandle Benchmarks (up to " << max_mb << " MB) ===\n";
+    FileHandle::set_tracing(false); // Keep close/move messages out of the timings
+    benchmark_map_vs_read(max_mb);
+    benchmark_lines(max_mb);
+    benchmark_buffered_writes(max_mb);
+    benchmark_append_log();
+    benchmark_async_reads(max_mb);
+    benchmark_handle_cache();
+    benchmark_copy(max_mb);
+    benchmark_record_replay(max_mb);
+    benchmark_compression(max_mb);
+    benchmark_direct_io(max_mb);
+}
+
+int main(int argc, char* argv[]) {
+    // "--bench [max_mb]" runs the I/O benchmarks instead of the kata tests (4096 for the full 1 MB - 4 GB sweep)
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        const std::size_t max_mb = argc > 2 ? std::stoul(argv[2]) : 64;
+        run_benchmarks(max_mb);
+        return 0;
+    }
+    // "--convert <text> <records>" turns a newline-delimited log into a binary record file
+    if (argc > 1 && std::string(argv[1]) == "--convert") {
+        if (argc != 4) {
+            std::cerr << "usage: " << argv[0] << " --convert <text-file> <record-file>\n";
+            return 2;
+        }
+        FileHandle::set_tracing(false);
+        try {
+            std::cout << convert_text_to_records(argv[2], argv[3]) << " records written to " << argv[3] << "\n";
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
     test_basic_raii();
     return 0;
 }
@@ -11,6 +11,27 @@
 #include <memory> // For std::unique_ptr  and std::make_unique std::unique_ptr: a smart pointer that manages a dynamically allocated object
 // For std::make_unique: a helper function to create unique_ptrs
 #include <vector> // For std::vector: a dynamic array container
+#include <stdexcept> // For std::runtime_error
+#include <string> // For command-line arguments
+#include <streambuf> // For the null stream in benchmarks
+#include <chrono> // For benchmark timing
+#include <array> // For the arena's backing storage
+#include <cstddef> // For std::byte
+#include <memory_resource> // For the pmr arena in the allocator-aware test
+#include <type_traits> // For array detection in the make helpers
+#include <numeric> // For std::iota in the frame benchmark
+#include <new> // For placement new and std::bad_alloc
+#include <mutex> // For the SlabPool central free lists
+#include <thread> // For multi-threaded benchmarks
+#include <algorithm> // For std::nth_element
+#include <cstdint> // For std::uint32_t latency samples
+#include <atomic> // For SimpleSharedPtr reference counts
+#include <utility> // For std::exchange and std::swap
+#include <random> // For shuffled traversal order
+#include <source_location> // For readable type names in allocation stats
+#include <string_view> // For type names
+#include <bit> // For std::countl_zero in the lifetime histogram
+#include <condition_variable> // For waking the epoch reclaim thread
 
 // Simple class for testing
 class Resource { // Represents a resource that we will manage with our smart pointer
@@ -40,32 +61,485 @@ private:
     int value_; // The value of the resource
 };
 
+// Trace policies: SimpleUniquePtr reports every ownership change to one of these. The default
+// NoTrace does nothing, so the calls inline away and a move is just two pointer stores;
+// VerboseTrace is the step-by-step std::cout narration, opt-in for learning and debugging.
+struct NoTrace {
+    static void constructed(const void*) noexcept {}
+    static void destroyed(const void*) noexcept {}
+    static void moved(const void*) noexcept {}
+    static void move_assigning(const void*, bool) noexcept {}
+    static void move_assigned(const void*) noexcept {}
+    static void released(const void*) noexcept {}
+    static void reset(const void*, const void*) noexcept {}
+};
+
+struct VerboseTrace {
+    static void constructed(const void* ptr) {
+        if (ptr) {
+            std::cout << "🔨 SimpleUniquePtr::Constructor - Taking ownership of pointer " << ptr << " (Resource exists)\n";
+        } else {
+            std::cout << "🔨 SimpleUniquePtr::Constructor - Created with nullptr (No resource)\n";
+        }
+    }
+
+    static void destroyed(const void* ptr) {
+        if (ptr) {
+            std::cout << "💀 SimpleUniquePtr::Destructor - Deleting pointer " << ptr << " (Resource will be destroyed)\n";
+        } else {
+            std::cout << "💀 SimpleUniquePtr::Destructor - Nothing to delete (ptr is nullptr)\n";
+        }
+    }
+
+    static void moved(const void* ptr) {
+        std::cout << "🚀 SimpleUniquePtr::Move Constructor - Transferring ownership of pointer " << ptr << " from source to destination\n";
+        std::cout << "🚀 SimpleUniquePtr::Move Constructor - Source pointer set to nullptr (moved-from state)\n";
+    }
+
+    // Called before the old object is deleted; 'self' is a self-assignment (nothing happens)
+    static void move_assigning(const void* old_ptr, bool self) {
+        std::cout << "⚡ SimpleUniquePtr::Move Assignment - Starting move assignment\n";
+        if (self) {
+            std::cout << "⚡ SimpleUniquePtr::Move Assignment - Self-assignment detected, doing nothing\n";
+            return;
+        }
+        std::cout << "⚡ SimpleUniquePtr::Move Assignment - Not self-assignment, proceeding\n";
+        if (old_ptr) {
+            std::cout << "⚡ SimpleUniquePtr::Move Assignment - Deleting old pointer " << old_ptr << " (old resource will be destroyed)\n";
+        } else {
+            std::cout << "⚡ SimpleUniquePtr::Move Assignment - No old resource to delete\n";
+        }
+    }
+
+    static void move_assigned(const void* new_ptr) {
+        std::cout << "⚡ SimpleUniquePtr::Move Assignment - Acquired pointer " << new_ptr << " from source\n";
+        std::cout << "⚡ SimpleUniquePtr::Move Assignment - Source pointer set to nullptr (moved-from state)\n";
+    }
+
+    static void released(const void* ptr) {
+        std::cout << "🔓 SimpleUniquePtr::Release - Released ownership of pointer " << ptr << " (caller now owns it)\n";
+    }
+
+    static void reset(const void* old_ptr, const void* new_ptr) {
+        if (old_ptr) {
+            std::cout << "🔄 SimpleUniquePtr::Reset - Deleting old pointer " << old_ptr << " (old resource will be destroyed)\n";
+        } else {
+            std::cout << "🔄 SimpleUniquePtr::Reset - No old resource to delete\n";
+        }
+        if (new_ptr) {
+            std::cout << "🔄 SimpleUniquePtr::Reset - Now managing new pointer " << new_ptr << " (new resource acquired)\n";
+        } else {
+            std::cout << "🔄 SimpleUniquePtr::Reset - Reset to nullptr (no resource)\n";
+        }
+    }
+};
+
+#ifndef KATA2_TRACK_ALLOCATIONS
+#define KATA2_TRACK_ALLOCATIONS 0
+#endif
+
+// Compile-time switch for AllocationTracker: build with -DKATA2_TRACK_ALLOCATIONS=1 (or the
+// CMake option of the same name). Off, the hooks sit behind if constexpr and compile away.
+inline constexpr bool kTrackAllocations = KATA2_TRACK_ALLOCATIONS != 0;
+
+// "Resource", "int []", ... from the compiler's signature for this instantiation
+template<typename T>
+constexpr std::string_view type_name() {
+    const std::string_view signature = std::source_location::current().function_name();
+    const std::size_t begin = signature.find("T = ");
+    if (begin == std::string_view::npos) {
+        return signature;
+    }
+    std::size_t end = signature.find(';', begin); // GCC lists more aliases after T; Clang just closes
+    if (end == std::string_view::npos) {
+        end = signature.rfind(']');
+    }
+    return signature.substr(begin + 4, end - begin - 4);
+}
+
+// Allocation statistics for make_simple_unique objects: per-type counts, bytes, live and peak
+// live objects, and a log2 histogram of lifetimes. The hot path takes no locks. Counters live
+// in per-thread blocks that only their own thread writes (plain relaxed stores, no contended
+// RMW) and are summed on demand; live = allocs - frees at that point. Peak live needs a global
+// view: each thread folds its live delta into a shared per-type counter whenever its own live
+// count reaches a new high (so a peak is never missed), and otherwise every kLiveBatch objects.
+// Steady churn below a thread's high-water mark stays off the shared line; peak_live may
+// overstate by frees other threads have not folded yet, under kLiveBatch per thread.
+// Births sit in a fixed-size lock-free hash table keyed by address, so a free on any thread, or
+// through a base-class pointer, is credited to the type that was allocated. Objects that did not
+// come from make_simple_unique are not in the table and are ignored; allocations that find no
+// free table slot within kMaxProbe probes are counted as 'untracked' instead.
+class AllocationTracker {
+public:
+    static constexpr std::size_t kMaxTypes = 64; // Later types share the last "(other)" slot
+    static constexpr std::size_t kLifetimeBuckets = 32; // Bucket b: below 2^b ns; the last is open-ended
+    static constexpr std::size_t kBirthSlots = std::size_t{1} << 18; // Tracked objects alive at once (8 MB table)
+    static constexpr std::size_t kMaxProbe = 32;
+    static constexpr std::int64_t kLiveBatch = 64;
+
+    struct TypeStats {
+        std::string name;
+        std::uint64_t allocs = 0;
+        std::uint64_t frees = 0;
+        std::uint64_t bytes_allocated = 0;
+        std::uint64_t bytes_freed = 0;
+        std::int64_t live = 0;
+        std::int64_t peak_live = 0;
+        std::array<std::uint64_t, kLifetimeBuckets> lifetimes{};
+    };
+
+    template<typename T>
+    static void allocated(const void* ptr, std::size_t bytes) {
+        const std::size_t type = slot<T>();
+        if (!state().births.insert(ptr, Birth{now_ns(), bytes, type})) {
+            state().untracked.fetch_add(1, std::memory_order_relaxed); // Table crowded: rare by construction
+            return;
+        }
+        count(type, 1, [bytes](Counters& counters) {
+            bump(counters.allocs, 1);
+            bump(counters.bytes_allocated, bytes);
+        });
+    }
+
+    static void freed(const void* ptr) noexcept {
+        if (!ptr) {
+            return;
+        }
+        Birth birth{};
+        if (!state().births.take(ptr, birth)) {
+            return; // Not from make_simple_unique
+        }
+        const auto width = static_cast<std::size_t>(64 - std::countl_zero(now_ns() - birth.ns)); // bit_width
+        const std::size_t bucket = std::min(width, kLifetimeBuckets - 1);
+        count(birth.type, -1, [&birth, bucket](Counters& counters) {
+            bump(counters.frees, 1);
+            bump(counters.bytes_freed, birth.bytes);
+            bump(counters.lifetimes[bucket], 1);
+        });
+    }
+
+    // Sum every thread's counters (including threads that have exited)
+    static std::vector<TypeStats> collect() {
+        State& s = state();
+        std::lock_guard<std::mutex> lock(s.registry_mutex);
+        std::vector<TypeStats> result(s.type_count);
+        for (std::size_t type = 0; type < result.size(); ++type) {
+            TypeStats& stats = result[type];
+            stats.name = s.types[type].name;
+            add(stats, s.retired[type]);
+            for (const ThreadCounters* thread : s.threads) {
+                add(stats, thread->types[type]);
+            }
+            stats.live = static_cast<std::int64_t>(stats.allocs - stats.frees);
+            stats.peak_live = std::max(s.types[type].peak.load(std::memory_order_relaxed), stats.live);
+        }
+        return result;
+    }
+
+    template<typename T>
+    static TypeStats stats() {
+        return collect()[slot<T>()];
+    }
+
+    static void dump_json(std::ostream& out) {
+        const std::vector<TypeStats> all = collect();
+        const double elapsed = static_cast<double>(now_ns()) / 1e9;
+        out << "{\"elapsed_s\": " << elapsed << ", \"untracked\": " << state().untracked.load(std::memory_order_relaxed)
+            << ", \"types\": [";
+        for (std::size_t type = 0; type < all.size(); ++type) {
+            const TypeStats& stats = all[type];
+            out << (type ? ", " : "") << "{\"type\": \"";
+            for (const char c : stats.name) {
+                if (c == '"' || c == '\\') {
+                    out << '\\';
+                }
+                out << c;
+            }
+            out << "\", \"allocs\": " << stats.allocs << ", \"frees\": " << stats.frees
+                << ", \"allocs_per_s\": " << (elapsed > 0.0 ? static_cast<double>(stats.allocs) / elapsed : 0.0)
+                << ", \"bytes_allocated\": " << stats.bytes_allocated << ", \"bytes_live\": "
+                << stats.bytes_allocated - stats.bytes_freed << ", \"live\": " << stats.live
+                << ", \"peak_live\": " << stats.peak_live << ", \"lifetime_ns\": [";
+            bool first = true;
+            for (std::size_t b = 0; b < kLifetimeBuckets; ++b) {
+                if (stats.lifetimes[b] == 0) {
+                    continue;
+                }
+                out << (first ? "" : ", ");
+                first = false;
+                if (b + 1 < kLifetimeBuckets) {
+                    out << "{\"below\": " << (std::uint64_t{1} << b);
+                } else {
+                    out << "{\"at_least\": " << (std::uint64_t{1} << (b - 1));
+                }
+                out << ", \"count\": " << stats.lifetimes[b] << "}";
+            }
+            out << "]}";
+        }
+        out << "]}\n";
+    }
+
+private:
+    struct Counters {
+        std::atomic<std::uint64_t> allocs{0};
+        std::atomic<std::uint64_t> frees{0};
+        std::atomic<std::uint64_t> bytes_allocated{0};
+        std::atomic<std::uint64_t> bytes_freed{0};
+        std::array<std::atomic<std::uint64_t>, kLifetimeBuckets> lifetimes{};
+    };
+
+    struct TypeInfo {
+        std::string_view name;
+        std::atomic<std::int64_t> live{0}; // Sum of flushed per-thread batches
+        std::atomic<std::int64_t> peak{0};
+    };
+
+    struct Birth {
+        std::uint64_t ns;
+        std::size_t bytes;
+        std::size_t type;
+    };
+
+    // Linear-probing table of live tracked objects. A slot is claimed by CAS on its key and the
+    // birth written afterwards; whoever frees the object received it from the allocating thread,
+    // so it already sees that write. Freed keys become tombstones, which later inserts reuse, so
+    // a lookup can stop at the first empty slot.
+    class BirthTable {
+    private:
+        struct Slot {
+            std::atomic<const void*> key{nullptr};
+            Birth birth{};
+        };
+
+        std::unique_ptr<Slot[]> slots_ = std::make_unique<Slot[]>(kBirthSlots);
+
+        static const void* tombstone() noexcept {
+            static const char mark = 0;
+            return &mark;
+        }
+
+        static std::size_t home(const void* ptr) noexcept {
+            return static_cast<std::size_t>((reinterpret_cast<std::uintptr_t>(ptr) >> 4) * 0x9E3779B97F4A7C15ull >>
+                                            (64 - std::countr_zero(kBirthSlots)));
+        }
+
+    public:
+        bool insert(const void* ptr, const Birth& birth) noexcept {
+            for (std::size_t i = 0; i < kMaxProbe; ++i) {
+                Slot& slot = slots_[(home(ptr) + i) & (kBirthSlots - 1)];
+                const void* key = slot.key.load(std::memory_order_relaxed);
+                if ((key == nullptr || key == tombstone()) &&
+                    slot.key.compare_exchange_strong(key, ptr, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    slot.birth = birth;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool take(const void* ptr, Birth& birth) noexcept {
+            for (std::size_t i = 0; i < kMaxProbe; ++i) {
+                Slot& slot = slots_[(home(ptr) + i) & (kBirthSlots - 1)];
+                const void* key = slot.key.load(std::memory_order_acquire);
+                if (key == ptr) {
+                    birth = slot.birth;
+                    slot.key.store(tombstone(), std::memory_order_release); // Orders the read before reuse
+                    return true;
+                }
+                if (key == nullptr) {
+                    return false;
+                }
+            }
+            return false;
+        }
+    };
+
+    struct ThreadCounters;
+
+    struct State {
+        std::mutex registry_mutex; // Guards threads, retired, type_count and names; never on the hot path
+        std::vector<ThreadCounters*> threads;
+        std::array<Counters, kMaxTypes> retired; // Folded in from exited threads
+        std::array<TypeInfo, kMaxTypes> types;
+        std::size_t type_count = 0;
+        BirthTable births;
+        std::atomic<std::uint64_t> untracked{0};
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    };
+
+    struct ThreadCounters {
+        std::array<Counters, kMaxTypes> types;
+        std::array<std::int64_t, kMaxTypes> live_delta{}; // Not yet folded into TypeInfo::live
+        std::array<std::int64_t, kMaxTypes> live{}; // Allocated minus freed on this thread
+        std::array<std::int64_t, kMaxTypes> live_peak{}; // High-water mark of 'live'
+
+        ThreadCounters() {
+            std::lock_guard<std::mutex> lock(state().registry_mutex);
+            state().threads.push_back(this);
+        }
+
+        ~ThreadCounters() {
+            State& s = state();
+            std::lock_guard<std::mutex> lock(s.registry_mutex);
+            for (std::size_t type = 0; type < kMaxTypes; ++type) {
+                merge(s.retired[type], types[type]);
+                fold_live(type, live_delta[type]);
+            }
+            s.threads.erase(std::find(s.threads.begin(), s.threads.end(), this));
+            thread_exited() = true;
+        }
+
+        ThreadCounters(const ThreadCounters&) = delete;
+        ThreadCounters& operator=(const ThreadCounters&) = delete;
+    };
+
+    static State& state() {
+        static State s;
+        return s;
+    }
+
+    static ThreadCounters& local() {
+        thread_local ThreadCounters counters;
+        return counters;
+    }
+
+    // Trivially destructible, so still readable from thread_local destructors that run after ours
+    static bool& thread_exited() noexcept {
+        thread_local bool exited = false;
+        return exited;
+    }
+
+    static void fold_live(std::size_t type, std::int64_t delta) noexcept {
+        TypeInfo& info = state().types[type];
+        const std::int64_t live = info.live.fetch_add(delta, std::memory_order_relaxed) + delta;
+        std::int64_t peak = info.peak.load(std::memory_order_relaxed);
+        while (live > peak && !info.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Apply 'update' to this thread's counters, or straight to the retired totals once they are gone
+    template<typename Update>
+    static void count(std::size_t type, std::int64_t live_delta, Update update) {
+        if (thread_exited()) {
+            std::lock_guard<std::mutex> lock(state().registry_mutex);
+            update(state().retired[type]);
+            fold_live(type, live_delta);
+            return;
+        }
+        ThreadCounters& counters = local();
+        update(counters.types[type]);
+        std::int64_t& pending = counters.live_delta[type];
+        pending += live_delta;
+        const std::int64_t live = counters.live[type] += live_delta;
+        const bool new_high = live > counters.live_peak[type];
+        if (new_high) {
+            counters.live_peak[type] = live;
+        }
+        if (new_high || pending >= kLiveBatch || pending <= -kLiveBatch) {
+            fold_live(type, pending);
+            pending = 0;
+        }
+    }
+
+    template<typename T>
+    static std::size_t slot() {
+        static const std::size_t index = register_type(type_name<T>());
+        return index;
+    }
+
+    static std::size_t register_type(std::string_view name) {
+        State& s = state();
+        std::lock_guard<std::mutex> lock(s.registry_mutex);
+        if (s.type_count < kMaxTypes - 1) {
+            s.types[s.type_count].name = name;
+            return s.type_count++;
+        }
+        s.types[kMaxTypes - 1].name = "(other)";
+        s.type_count = kMaxTypes;
+        return kMaxTypes - 1;
+    }
+
+    static std::uint64_t now_ns() noexcept {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                              std::chrono::steady_clock::now() - state().start).count());
+    }
+
+    // Single writer per counter block: a load and a store, not a locked read-modify-write
+    static void bump(std::atomic<std::uint64_t>& counter, std::uint64_t by) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    static void merge(Counters& into, const Counters& from) noexcept {
+        bump(into.allocs, from.allocs.load(std::memory_order_relaxed));
+        bump(into.frees, from.frees.load(std::memory_order_relaxed));
+        bump(into.bytes_allocated, from.bytes_allocated.load(std::memory_order_relaxed));
+        bump(into.bytes_freed, from.bytes_freed.load(std::memory_order_relaxed));
+        for (std::size_t b = 0; b < kLifetimeBuckets; ++b) {
+            bump(into.lifetimes[b], from.lifetimes[b].load(std::memory_order_relaxed));
+        }
+    }
+
+    static void add(TypeStats& stats, const Counters& counters) noexcept {
+        stats.allocs += counters.allocs.load(std::memory_order_relaxed);
+        stats.frees += counters.frees.load(std::memory_order_relaxed);
+        stats.bytes_allocated += counters.bytes_allocated.load(std::memory_order_relaxed);
+        stats.bytes_freed += counters.bytes_freed.load(std::memory_order_relaxed);
+        for (std::size_t b = 0; b < kLifetimeBuckets; ++b) {
+            stats.lifetimes[b] += counters.lifetimes[b].load(std::memory_order_relaxed);
+        }
+    }
+};
+
+// Default deleter: plain delete, like std::default_delete. Empty, so it costs no storage.
+template<typename T>
+struct DefaultDelete {
+    void operator()(T* ptr) const noexcept {
+        if constexpr (kTrackAllocations) {
+            AllocationTracker::freed(ptr);
+        }
+        delete ptr;
+    }
+};
+
+// Arrays from new[] must go back through delete[]
+template<typename T>
+struct DefaultDelete<T[]> {
+    void operator()(T* ptr) const noexcept {
+        if constexpr (kTrackAllocations) {
+            AllocationTracker::freed(ptr);
+        }
+        delete[] ptr;
+    }
+};
+
 // TODO: Implement SimpleUniquePtr class
-template<typename T> // A simple unique pointer implementation  
+// Deleter is any callable taking T* (empty ones take no space thanks to [[no_unique_address]];
+// stateful ones such as an allocator or arena handle are stored next to the pointer).
+template<typename T, typename Deleter = DefaultDelete<T>, typename TracePolicy = NoTrace> // A simple unique pointer implementation
 class SimpleUniquePtr { // A simple unique pointer that manages a dynamically allocated object of type T
 private:
-    T* ptr_; // Raw pointer to the managed object
+    T* ptr_; // Raw pointer to the managed object (the policy is stateless: no extra bytes)
+    [[no_unique_address]] Deleter deleter_; // How to free it
 
 public:
     // Constructor - takes ownership of raw pointer
-    explicit SimpleUniquePtr(T* ptr = nullptr) : ptr_(ptr) {
+    explicit SimpleUniquePtr(T* ptr = nullptr) : ptr_(ptr), deleter_() {
         // RAII: We acquire the resource (take ownership of the pointer)
         // The 'explicit' keyword prevents implicit conversions
-        if (ptr_) {
-            std::cout << "🔨 SimpleUniquePtr::Constructor - Taking ownership of pointer " << ptr_ << " (Resource exists)\n";
-        } else {
-            std::cout << "🔨 SimpleUniquePtr::Constructor - Created with nullptr (No resource)\n";
-        }
+        TracePolicy::constructed(ptr_);
+    }
+
+    // Take ownership of a pointer that must be freed with 'deleter'
+    SimpleUniquePtr(T* ptr, Deleter deleter) noexcept : ptr_(ptr), deleter_(std::move(deleter)) {
+        TracePolicy::constructed(ptr_);
     }
     
     // Destructor - delete the managed object
     ~SimpleUniquePtr() {
         // RAII: We release the resource (delete the object)
+        TracePolicy::destroyed(ptr_);
         if (ptr_) {
-            std::cout << "💀 SimpleUniquePtr::Destructor - Deleting pointer " << ptr_ << " (Resource will be destroyed)\n";
-            delete ptr_;
-        } else {
-            std::cout << "💀 SimpleUniquePtr::Destructor - Nothing to delete (ptr is nullptr)\n";
+            deleter_(ptr_);
         }
     }
     
@@ -74,115 +548,1642 @@ public:
     SimpleUniquePtr& operator=(const SimpleUniquePtr&) = delete;
     
     // Move constructor - transfer ownership
-    SimpleUniquePtr(SimpleUniquePtr&& other) noexcept : ptr_(other.ptr_) {
+    SimpleUniquePtr(SimpleUniquePtr&& other) noexcept : ptr_(other.ptr_), deleter_(std::move(other.deleter_)) {
         // Move semantics: Transfer ownership from 'other' to 'this'
         // 1. Take the pointer from 'other'
         // 2. Set 'other' to null (moved-from state)
-        std::cout << "🚀 SimpleUniquePtr::Move Constructor - Transferring ownership of pointer " << ptr_ << " from source to destination\n";
         other.ptr_ = nullptr;  // Leave 'other' in a valid but empty state
-        std::cout << "🚀 SimpleUniquePtr::Move Constructor - Source pointer set to nullptr (moved-from state)\n";
+        TracePolicy::moved(ptr_);
     }
     
     // Move assignment - transfer ownership
     SimpleUniquePtr& operator=(SimpleUniquePtr&& other) noexcept {
         // Move assignment: Transfer ownership from 'other' to 'this'
-        std::cout << "⚡ SimpleUniquePtr::Move Assignment - Starting move assignment\n";
+        TracePolicy::move_assigning(ptr_, this == &other);
         if (this != &other) {  // Self-assignment check
-            std::cout << "⚡ SimpleUniquePtr::Move Assignment - Not self-assignment, proceeding\n";
             // 1. Clean up our current resource
             if (ptr_) {
-                std::cout << "⚡ SimpleUniquePtr::Move Assignment - Deleting old pointer " << ptr_ << " (old resource will be destroyed)\n";
-                delete ptr_;
-            } else {
-                std::cout << "⚡ SimpleUniquePtr::Move Assignment - No old resource to delete\n";
+                deleter_(ptr_);
             }
-            // 2. Take ownership from 'other'
+            // 2. Take ownership from 'other' (a stateful deleter comes along)
             ptr_ = other.ptr_;
-            std::cout << "⚡ SimpleUniquePtr::Move Assignment - Acquired pointer " << ptr_ << " from source\n";
+            deleter_ = std::move(other.deleter_);
             // 3. Leave 'other' in valid but empty state
             other.ptr_ = nullptr;
-            std::cout << "⚡ SimpleUniquePtr::Move Assignment - Source pointer set to nullptr (moved-from state)\n";
-        } else {
-            std::cout << "⚡ SimpleUniquePtr::Move Assignment - Self-assignment detected, doing nothing\n";
+            TracePolicy::move_assigned(ptr_);
+        }
+        return *this;
+    }
+    
+    // TODO: Dereference operators
+    T& operator*() const {
+        // Your implementation here
+        if (!ptr_) {
+            throw std::runtime_error("Dereferencing a null pointer");
+        }
+        return *ptr_; // Dereference the pointer to access the object
+    }
+    
+    T* operator->() const {
+        // Your implementation here'
+        if (!ptr_) {
+            throw std::runtime_error("Dereferencing a null pointer");
+        }
+        return ptr_; // Return the raw pointer to access the object's members
+    }
+    
+    // TODO: Get raw pointer
+    T* get() const {
+        // Your implementation here
+        return ptr_; // Return the raw pointer to the managed object
+    }
+    
+    // TODO: Release ownership
+    T* release() {
+        // Your implementation here
+        T* temp = ptr_; // Store the current pointer
+        ptr_ = nullptr; // Leave the pointer in a null state
+        TracePolicy::released(temp);
+        return temp; // Return the raw pointer, transferring ownership
+    }
+    
+    // TODO: Reset with new pointer
+    void reset(T* ptr = nullptr) {
+        // Your implementation 
+        TracePolicy::reset(ptr_, ptr);
+        T* old = ptr_;
+        ptr_ = ptr; // Take ownership of the new pointer
+        if (old) {
+            deleter_(old); // Delete the current object with the same deleter
+        }
+    }
+
+    Deleter& get_deleter() noexcept {
+        return deleter_;
+    }
+
+    const Deleter& get_deleter() const noexcept {
+        return deleter_;
+    }
+    
+    // TODO: Check if pointer is valid
+    explicit operator bool() const {
+        // Your implementation here
+        return ptr_ != nullptr; // Return true if the pointer is not null
+    }
+};
+
+// Array specialization for buffers from new T[n]: indexing instead of * and ->, and the default
+// deleter is delete[]. Like std::unique_ptr<T[]> it does not remember the element count.
+template<typename T, typename Deleter, typename TracePolicy>
+class SimpleUniquePtr<T[], Deleter, TracePolicy> {
+private:
+    T* ptr_; // First element of the managed array
+    [[no_unique_address]] Deleter deleter_;
+
+public:
+    explicit SimpleUniquePtr(T* ptr = nullptr) : ptr_(ptr), deleter_() {
+        TracePolicy::constructed(ptr_);
+    }
+
+    SimpleUniquePtr(T* ptr, Deleter deleter) noexcept : ptr_(ptr), deleter_(std::move(deleter)) {
+        TracePolicy::constructed(ptr_);
+    }
+
+    ~SimpleUniquePtr() {
+        TracePolicy::destroyed(ptr_);
+        if (ptr_) {
+            deleter_(ptr_);
+        }
+    }
+
+    SimpleUniquePtr(const SimpleUniquePtr&) = delete;
+    SimpleUniquePtr& operator=(const SimpleUniquePtr&) = delete;
+
+    SimpleUniquePtr(SimpleUniquePtr&& other) noexcept : ptr_(other.ptr_), deleter_(std::move(other.deleter_)) {
+        other.ptr_ = nullptr;
+        TracePolicy::moved(ptr_);
+    }
+
+    SimpleUniquePtr& operator=(SimpleUniquePtr&& other) noexcept {
+        TracePolicy::move_assigning(ptr_, this == &other);
+        if (this != &other) {
+            if (ptr_) {
+                deleter_(ptr_);
+            }
+            ptr_ = other.ptr_;
+            deleter_ = std::move(other.deleter_);
+            other.ptr_ = nullptr;
+            TracePolicy::move_assigned(ptr_);
+        }
+        return *this;
+    }
+
+    // Unchecked, like a raw array: the pointer does not know the length
+    T& operator[](std::size_t index) const {
+        return ptr_[index];
+    }
+
+    T* get() const {
+        return ptr_;
+    }
+
+    T* release() {
+        T* temp = ptr_;
+        ptr_ = nullptr;
+        TracePolicy::released(temp);
+        return temp;
+    }
+
+    void reset(T* ptr = nullptr) {
+        TracePolicy::reset(ptr_, ptr);
+        T* old = ptr_;
+        ptr_ = ptr;
+        if (old) {
+            deleter_(old);
+        }
+    }
+
+    Deleter& get_deleter() noexcept {
+        return deleter_;
+    }
+
+    const Deleter& get_deleter() const noexcept {
+        return deleter_;
+    }
+
+    explicit operator bool() const {
+        return ptr_ != nullptr;
+    }
+};
+
+// Deleter for objects made by allocate_simple_unique: destroy and deallocate through a copy of
+// the allocator (already rebound to T). Empty for std::allocator, one pointer for a pmr arena.
+template<typename T, typename Alloc>
+struct AllocatorDelete {
+    [[no_unique_address]] Alloc alloc;
+
+    void operator()(T* ptr) {
+        std::allocator_traits<Alloc>::destroy(alloc, ptr);
+        std::allocator_traits<Alloc>::deallocate(alloc, ptr, 1);
+    }
+};
+
+// Tracing and stateless deleters must stay free: the default pointer is exactly one raw pointer
+static_assert(sizeof(SimpleUniquePtr<Resource>) == sizeof(Resource*));
+static_assert(sizeof(SimpleUniquePtr<Resource, DefaultDelete<Resource>, VerboseTrace>) == sizeof(Resource*));
+static_assert(sizeof(SimpleUniquePtr<Resource, AllocatorDelete<Resource, std::allocator<Resource>>>) == sizeof(Resource*));
+
+// TODO: Implement make_simple_unique helper function
+template<typename T, typename TracePolicy = NoTrace, typename... Args>
+    requires (!std::is_array_v<T>)
+SimpleUniquePtr<T, DefaultDelete<T>, TracePolicy> make_simple_unique(Args&&... args) 
+
+{
+    // This function creates a SimpleUniquePtr by allocating a new object of type T
+    // and forwarding the arguments to its constructor
+    SimpleUniquePtr<T, DefaultDelete<T>, TracePolicy> owner(new T(std::forward<Args>(args)...));
+    if constexpr (kTrackAllocations) {
+        AllocationTracker::allocated<T>(owner.get(), sizeof(T));
+    }
+    return owner;
+}
+
+// Array of n value-initialized elements (zeros for arithmetic types): make_simple_unique<float[]>(n)
+template<typename T, typename TracePolicy = NoTrace>
+    requires std::is_unbounded_array_v<T>
+SimpleUniquePtr<T, DefaultDelete<T>, TracePolicy> make_simple_unique(std::size_t n) {
+    SimpleUniquePtr<T, DefaultDelete<T>, TracePolicy> owner(new std::remove_extent_t<T>[n]());
+    if constexpr (kTrackAllocations) {
+        AllocationTracker::allocated<T>(owner.get(), n * sizeof(std::remove_extent_t<T>));
+    }
+    return owner;
+}
+
+// Default-initialized variants for memory that is about to be overwritten: trivially
+// constructible elements are left indeterminate instead of being zeroed first
+template<typename T, typename TracePolicy = NoTrace>
+    requires (!std::is_array_v<T>)
+SimpleUniquePtr<T, DefaultDelete<T>, TracePolicy> make_simple_unique_for_overwrite() {
+    SimpleUniquePtr<T, DefaultDelete<T>, TracePolicy> owner(new T);
+    if constexpr (kTrackAllocations) {
+        AllocationTracker::allocated<T>(owner.get(), sizeof(T));
+    }
+    return owner;
+}
+
+template<typename T, typename TracePolicy = NoTrace>
+    requires std::is_unbounded_array_v<T>
+SimpleUniquePtr<T, DefaultDelete<T>, TracePolicy> make_simple_unique_for_overwrite(std::size_t n) {
+    SimpleUniquePtr<T, DefaultDelete<T>, TracePolicy> owner(new std::remove_extent_t<T>[n]);
+    if constexpr (kTrackAllocations) {
+        AllocationTracker::allocated<T>(owner.get(), n * sizeof(std::remove_extent_t<T>));
+    }
+    return owner;
+}
+
+// Allocator-aware sibling of make_simple_unique (cf. std::allocate_shared): the object lives in
+// memory from 'alloc', and the returned pointer carries the allocator to give it back
+template<typename T, typename Alloc, typename... Args>
+    requires (!std::is_array_v<T>)
+auto allocate_simple_unique(const Alloc& alloc, Args&&... args) {
+    using Rebound = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+    using Traits = std::allocator_traits<Rebound>;
+    Rebound rebound(alloc);
+    T* ptr = Traits::allocate(rebound, 1);
+    try {
+        Traits::construct(rebound, ptr, std::forward<Args>(args)...);
+    } catch (...) {
+        Traits::deallocate(rebound, ptr, 1); // Constructor threw: no object to destroy
+        throw;
+    }
+    return SimpleUniquePtr<T, AllocatorDelete<T, Rebound>>(ptr, AllocatorDelete<T, Rebound>{std::move(rebound)});
+}
+
+// Small-object pool behind make_pooled_unique. Sizes up to max_size are rounded up to a
+// multiple of 'granularity', and each of those size classes has its own free lists:
+//  - every thread keeps a private free list per class, so most allocate/deallocate calls
+//    are a pointer pop/push with no locking;
+//  - an empty thread list refills with a batch of blocks from the central pool for that
+//    class (recycled batches first, otherwise carved from a 64 KB slab);
+//  - a thread list that grows past two batches hands one back, and a thread gives back all
+//    of its blocks when it exits.
+// Blocks freed on another thread simply join that thread's list. Slabs are kept until exit.
+class SlabPool {
+public:
+    static constexpr std::size_t granularity = 16; // Also the block alignment
+    static constexpr std::size_t max_size = 256;
+    static constexpr std::size_t classes = max_size / granularity;
+    static constexpr std::size_t batch = 64; // Blocks moved between a thread and the central pool at once
+    static constexpr std::size_t slab_bytes = std::size_t{64} << 10;
+
+    // Objects bigger than max_size or over-aligned go to the global allocator
+    static constexpr bool pooled(std::size_t size, std::size_t alignment) noexcept {
+        return size <= max_size && alignment <= granularity;
+    }
+
+    static void* allocate(std::size_t size) {
+        if (size > max_size) {
+            return ::operator new(size);
+        }
+        const std::size_t c = size_class(size);
+        ThreadCache& cache = thread_cache();
+        if (!cache.lists[c].head) {
+            refill(c, cache.lists[c]);
+        }
+        FreeList& list = cache.lists[c];
+        FreeBlock* block = list.head;
+        list.head = block->next;
+        --list.count;
+        return block;
+    }
+
+    static void deallocate(void* ptr, std::size_t size) noexcept {
+        if (size > max_size) {
+            ::operator delete(ptr);
+            return;
+        }
+        const std::size_t c = size_class(size);
+        FreeList& list = thread_cache().lists[c];
+        list.head = ::new (ptr) FreeBlock{list.head};
+        if (++list.count > 2 * batch) {
+            give_back(c, list, batch); // Bound what one thread can hoard
+        }
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct FreeList {
+        FreeBlock* head = nullptr;
+        std::size_t count = 0;
+    };
+
+    struct Central {
+        std::mutex mutex;
+        std::vector<FreeList> batches; // Returned by threads, reused before carving more
+        std::vector<void*> slabs;
+        std::byte* carve = nullptr; // Unused tail of the newest slab
+        std::size_t carve_left = 0;
+
+        ~Central() {
+            for (void* slab : slabs) {
+                ::operator delete(slab);
+            }
+        }
+    };
+
+    struct ThreadCache {
+        std::array<FreeList, classes> lists{};
+
+        ~ThreadCache() {
+            for (std::size_t c = 0; c < classes; ++c) {
+                if (lists[c].count > 0) {
+                    give_back(c, lists[c], lists[c].count);
+                }
+            }
+        }
+    };
+
+    static std::size_t size_class(std::size_t size) noexcept {
+        return size == 0 ? 0 : (size - 1) / granularity;
+    }
+
+    static Central& central(std::size_t c) {
+        static std::array<Central, classes> pools; // Destroyed after every thread's cache
+        return pools[c];
+    }
+
+    static ThreadCache& thread_cache() {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+
+    static void refill(std::size_t c, FreeList& list) {
+        Central& pool = central(c);
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        if (!pool.batches.empty()) {
+            list = pool.batches.back();
+            pool.batches.pop_back();
+            return;
+        }
+        const std::size_t block_size = (c + 1) * granularity;
+        if (pool.carve_left < block_size * batch) {
+            pool.slabs.reserve(pool.slabs.size() + 1); // Nothing leaks if this throws
+            pool.carve = static_cast<std::byte*>(::operator new(slab_bytes));
+            pool.slabs.push_back(pool.carve);
+            pool.carve_left = slab_bytes;
+        }
+        for (std::size_t i = 0; i < batch; ++i) {
+            list.head = ::new (pool.carve) FreeBlock{list.head};
+            pool.carve += block_size;
+        }
+        pool.carve_left -= block_size * batch;
+        list.count = batch;
+    }
+
+    // Detach 'n' blocks from the front of 'list' and park them in the central pool
+    static void give_back(std::size_t c, FreeList& list, std::size_t n) noexcept {
+        FreeList returned{list.head, n};
+        FreeBlock* last = list.head;
+        for (std::size_t i = 1; i < n; ++i) {
+            last = last->next;
+        }
+        list.head = last->next;
+        list.count -= n;
+        last->next = nullptr;
+        Central& pool = central(c);
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        try {
+            pool.batches.push_back(returned);
+        } catch (const std::bad_alloc&) {
+            // Out of memory for the bookkeeping: these blocks stay unused until exit
+        }
+    }
+};
+
+// Deleter for make_pooled_unique: destroy in place, then hand the block back to the pool
+template<typename T>
+struct PoolDelete {
+    void operator()(T* ptr) const noexcept {
+        ptr->~T();
+        SlabPool::deallocate(ptr, sizeof(T));
+    }
+};
+
+// make_simple_unique for hot paths: the object lives in a SlabPool block instead of a global
+// new allocation. The deleter is empty, so the pointer is still sizeof(T*).
+template<typename T, typename... Args>
+    requires (!std::is_array_v<T> && SlabPool::pooled(sizeof(T), alignof(T)))
+SimpleUniquePtr<T, PoolDelete<T>> make_pooled_unique(Args&&... args) {
+    void* memory = SlabPool::allocate(sizeof(T));
+    try {
+        return SimpleUniquePtr<T, PoolDelete<T>>(::new (memory) T(std::forward<Args>(args)...), PoolDelete<T>{});
+    } catch (...) {
+        SlabPool::deallocate(memory, sizeof(T));
+        throw;
+    }
+}
+
+// Monotonic bump-pointer arena for objects that all die together (e.g. one planning tick).
+// Memory comes from a chain of chunks; allocate() only advances a cursor, moving on to the
+// next chunk (or chaining a new one) when the current one is full. reset() rewinds to the
+// first chunk in O(1) and keeps the chain for the next round; chunks are freed in the destructor.
+// Pinned: handles from make_arena_unique() point into it. Every handle must be gone before reset().
+class Arena {
+private:
+    struct Chunk {
+        Chunk* next;
+        std::size_t size; // Usable bytes after the header
+    };
+
+    std::size_t chunk_size_;
+    Chunk* first_ = nullptr;
+    Chunk* current_ = nullptr;
+    std::byte* cursor_ = nullptr;
+    std::byte* end_ = nullptr;
+    std::size_t chunks_ = 0;
+
+    static std::byte* chunk_data(Chunk* chunk) noexcept {
+        return reinterpret_cast<std::byte*>(chunk) + sizeof(Chunk);
+    }
+
+    void enter(Chunk* chunk) noexcept {
+        current_ = chunk;
+        cursor_ = chunk_data(chunk);
+        end_ = cursor_ + chunk->size;
+    }
+
+    // Slow path of allocate(): reuse the next chunk of the chain if it fits, else link a new one
+    void* allocate_from_next_chunk(std::size_t size, std::size_t alignment) {
+        const std::size_t needed = size + alignment - 1; // Worst-case padding included
+        if (current_ && current_->next && current_->next->size >= needed) {
+            enter(current_->next);
+        } else {
+            const std::size_t usable = std::max(chunk_size_, needed);
+            auto* chunk = static_cast<Chunk*>(::operator new(sizeof(Chunk) + usable));
+            chunk->size = usable;
+            chunk->next = current_ ? current_->next : nullptr; // Splice in, keeping later chunks
+            if (current_) {
+                current_->next = chunk;
+            } else {
+                first_ = chunk;
+            }
+            ++chunks_;
+            enter(chunk);
+        }
+        return allocate(size, alignment);
+    }
+
+public:
+    explicit Arena(std::size_t chunk_size = std::size_t{64} << 10) : chunk_size_(chunk_size) {}
+
+    ~Arena() {
+        for (Chunk* chunk = first_; chunk;) {
+            Chunk* next = chunk->next;
+            ::operator delete(chunk);
+            chunk = next;
+        }
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    Arena(Arena&&) = delete;
+    Arena& operator=(Arena&&) = delete;
+
+    // 'alignment' must be a power of two no larger than alignof(std::max_align_t)
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+        const auto address = reinterpret_cast<std::uintptr_t>(cursor_);
+        const std::size_t padding = (alignment - address % alignment) % alignment;
+        if (cursor_ && static_cast<std::size_t>(end_ - cursor_) >= size + padding) {
+            std::byte* result = cursor_ + padding;
+            cursor_ = result + size;
+            return result;
+        }
+        return allocate_from_next_chunk(size, alignment);
+    }
+
+    // Release everything at once. Destructors are not run: destroy the handles first.
+    void reset() noexcept {
+        if (first_) {
+            enter(first_);
+        }
+    }
+
+    std::size_t chunk_count() const noexcept {
+        return chunks_;
+    }
+};
+
+// Deleter for arena handles: run the destructor only. The memory belongs to the Arena and is
+// reclaimed by Arena::reset(), so for trivially destructible types this does nothing at all.
+template<typename T>
+struct ArenaDelete {
+    void operator()(T* ptr) const noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            ptr->~T();
+        }
+    }
+};
+
+template<typename T>
+using ArenaPtr = SimpleUniquePtr<T, ArenaDelete<T>>;
+
+static_assert(sizeof(ArenaPtr<Resource>) == sizeof(Resource*));
+
+// Construct a T in 'arena'; the handle destroys it but never frees the memory
+template<typename T, typename... Args>
+    requires (!std::is_array_v<T> && alignof(T) <= alignof(std::max_align_t))
+ArenaPtr<T> make_arena_unique(Arena& arena, Args&&... args) {
+    void* memory = arena.allocate(sizeof(T), alignof(T));
+    return ArenaPtr<T>(::new (memory) T(std::forward<Args>(args)...), ArenaDelete<T>{}); // A throwing constructor just wastes the bytes
+}
+
+// Reference-count policies for SimpleSharedPtr. AtomicCount is safe to share across threads:
+// increments are relaxed (a new owner can only come from an existing one, which keeps the
+// object alive), decrements are acq_rel so the last owner sees every other owner's writes
+// before destroying. NonAtomicCount is plain integers for graphs confined to one thread.
+struct AtomicCount {
+    using Counter = std::atomic<long>;
+
+    static void increment(Counter& count) noexcept {
+        count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Returns the new value
+    static long decrement(Counter& count) noexcept {
+        return count.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    }
+
+    // For SimpleWeakPtr::lock(): take a reference only while the object still exists
+    static bool increment_if_nonzero(Counter& count) noexcept {
+        long current = count.load(std::memory_order_relaxed);
+        while (current != 0) {
+            if (count.compare_exchange_weak(current, current + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static long load(const Counter& count) noexcept {
+        return count.load(std::memory_order_relaxed);
+    }
+};
+
+struct NonAtomicCount {
+    using Counter = long;
+
+    static void increment(Counter& count) noexcept { ++count; }
+    static long decrement(Counter& count) noexcept { return --count; }
+
+    static bool increment_if_nonzero(Counter& count) noexcept {
+        if (count == 0) {
+            return false;
+        }
+        ++count;
+        return true;
+    }
+
+    static long load(const Counter& count) noexcept { return count; }
+};
+
+// Counts and object in one allocation. 'weak' includes one reference held jointly by all
+// strong owners, so the block outlives the object until the last SimpleWeakPtr lets go.
+template<typename T, typename CountPolicy>
+struct SharedControlBlock {
+    typename CountPolicy::Counter strong{1};
+    typename CountPolicy::Counter weak{1};
+    alignas(T) std::byte storage[sizeof(T)]; // The object, constructed by make_simple_shared
+
+    T* object() noexcept {
+        return std::launder(reinterpret_cast<T*>(storage));
+    }
+
+    void release_strong() noexcept {
+        if (CountPolicy::decrement(strong) == 0) {
+            object()->~T();
+            release_weak();
+        }
+    }
+
+    void release_weak() noexcept {
+        if (CountPolicy::decrement(weak) == 0) {
+            delete this;
+        }
+    }
+};
+
+template<typename T, typename CountPolicy = AtomicCount>
+class SimpleSharedPtr;
+
+template<typename T, typename CountPolicy = AtomicCount>
+class SimpleWeakPtr;
+
+template<typename T, typename CountPolicy = AtomicCount, typename... Args>
+SimpleSharedPtr<T, CountPolicy> make_simple_shared(Args&&... args);
+
+// Shared ownership with the control block co-allocated next to the object: one allocation per
+// object, and the handle itself is a single pointer (std::shared_ptr carries two). Objects are
+// created only through make_simple_shared; there is no adopting of raw pointers.
+template<typename T, typename CountPolicy>
+class SimpleSharedPtr {
+private:
+    using Block = SharedControlBlock<T, CountPolicy>;
+    Block* block_ = nullptr; // Holds one strong reference when non-null
+
+    explicit SimpleSharedPtr(Block* block) noexcept : block_(block) {} // Adopts a reference
+
+    template<typename U, typename P, typename... Args>
+    friend SimpleSharedPtr<U, P> make_simple_shared(Args&&... args);
+    friend class SimpleWeakPtr<T, CountPolicy>;
+
+public:
+    SimpleSharedPtr() noexcept = default;
+
+    ~SimpleSharedPtr() {
+        if (block_) {
+            block_->release_strong();
+        }
+    }
+
+    SimpleSharedPtr(const SimpleSharedPtr& other) noexcept : block_(other.block_) {
+        if (block_) {
+            CountPolicy::increment(block_->strong);
+        }
+    }
+
+    SimpleSharedPtr(SimpleSharedPtr&& other) noexcept : block_(std::exchange(other.block_, nullptr)) {}
+
+    SimpleSharedPtr& operator=(const SimpleSharedPtr& other) noexcept {
+        SimpleSharedPtr(other).swap(*this); // Increment before releasing: safe for self-assignment
+        return *this;
+    }
+
+    SimpleSharedPtr& operator=(SimpleSharedPtr&& other) noexcept {
+        SimpleSharedPtr(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    void swap(SimpleSharedPtr& other) noexcept {
+        std::swap(block_, other.block_);
+    }
+
+    void reset() noexcept {
+        SimpleSharedPtr().swap(*this);
+    }
+
+    T& operator*() const {
+        if (!block_) {
+            throw std::runtime_error("Dereferencing a null pointer");
+        }
+        return *block_->object();
+    }
+
+    T* operator->() const {
+        if (!block_) {
+            throw std::runtime_error("Dereferencing a null pointer");
+        }
+        return block_->object();
+    }
+
+    T* get() const noexcept {
+        return block_ ? block_->object() : nullptr;
+    }
+
+    // Number of SimpleSharedPtrs owning the object (a snapshot when other threads hold copies)
+    long use_count() const noexcept {
+        return block_ ? CountPolicy::load(block_->strong) : 0;
+    }
+
+    explicit operator bool() const noexcept {
+        return block_ != nullptr;
+    }
+};
+
+// Non-owning observer of a SimpleSharedPtr's object: keeps the control block, not the object
+template<typename T, typename CountPolicy>
+class SimpleWeakPtr {
+private:
+    using Block = SharedControlBlock<T, CountPolicy>;
+    Block* block_ = nullptr; // Holds one weak reference when non-null
+
+public:
+    SimpleWeakPtr() noexcept = default;
+
+    SimpleWeakPtr(const SimpleSharedPtr<T, CountPolicy>& shared) noexcept : block_(shared.block_) {
+        if (block_) {
+            CountPolicy::increment(block_->weak);
+        }
+    }
+
+    ~SimpleWeakPtr() {
+        if (block_) {
+            block_->release_weak();
+        }
+    }
+
+    SimpleWeakPtr(const SimpleWeakPtr& other) noexcept : block_(other.block_) {
+        if (block_) {
+            CountPolicy::increment(block_->weak);
+        }
+    }
+
+    SimpleWeakPtr(SimpleWeakPtr&& other) noexcept : block_(std::exchange(other.block_, nullptr)) {}
+
+    SimpleWeakPtr& operator=(SimpleWeakPtr other) noexcept { // By value: covers copy and move
+        std::swap(block_, other.block_);
+        return *this;
+    }
+
+    // A new owner if the object still exists, else an empty pointer
+    SimpleSharedPtr<T, CountPolicy> lock() const noexcept {
+        if (block_ && CountPolicy::increment_if_nonzero(block_->strong)) {
+            return SimpleSharedPtr<T, CountPolicy>(block_);
+        }
+        return SimpleSharedPtr<T, CountPolicy>();
+    }
+
+    bool expired() const noexcept {
+        return !block_ || CountPolicy::load(block_->strong) == 0;
+    }
+};
+
+static_assert(sizeof(SimpleSharedPtr<Resource>) == sizeof(Resource*));
+
+// Construct a T and its counts in a single allocation
+template<typename T, typename CountPolicy, typename... Args>
+SimpleSharedPtr<T, CountPolicy> make_simple_shared(Args&&... args) {
+    auto* block = new SharedControlBlock<T, CountPolicy>; // Storage left uninitialized
+    try {
+        ::new (static_cast<void*>(block->storage)) T(std::forward<Args>(args)...);
+    } catch (...) {
+        delete block;
+        throw;
+    }
+    return SimpleSharedPtr<T, CountPolicy>(block);
+}
+
+// CRTP base that embeds the reference count in the object itself, for IntrusivePtr. The count
+// is 4 bytes inside T instead of a separate control block; it starts at 0 and is not copied
+// with the object. T must be allocated with new (the last release deletes it).
+template<typename T>
+class RefCounted {
+private:
+    mutable std::atomic<std::uint32_t> ref_count_{0};
+
+protected:
+    RefCounted() noexcept = default;
+    RefCounted(const RefCounted&) noexcept {} // A copy is a new object with its own owners
+    RefCounted& operator=(const RefCounted&) noexcept { return *this; }
+    ~RefCounted() = default;
+
+public:
+    void retain() const noexcept {
+        ref_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void release() const noexcept {
+        if (ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            const T* self = static_cast<const T*>(this);
+            if constexpr (kTrackAllocations) {
+                AllocationTracker::freed(self); // Adopted from make_simple_unique
+            }
+            delete self;
+        }
+    }
+
+    std::uint32_t ref_count() const noexcept {
+        return ref_count_.load(std::memory_order_relaxed);
+    }
+};
+
+// Tag for IntrusivePtr's adopting constructor
+struct AdoptRef {
+    explicit AdoptRef() = default;
+};
+inline constexpr AdoptRef adopt_ref{};
+
+// Shared owner of a RefCounted<T> object: one pointer, and copies touch the count that lives
+// in the object's own cache line. IntrusivePtr(p) retains a new reference; IntrusivePtr(p,
+// adopt_ref) takes over one the caller already holds (e.g. from detach()).
+template<typename T>
+class IntrusivePtr {
+private:
+    T* ptr_ = nullptr;
+
+public:
+    IntrusivePtr() noexcept = default;
+
+    explicit IntrusivePtr(T* ptr) noexcept : ptr_(ptr) {
+        if (ptr_) {
+            ptr_->retain();
+        }
+    }
+
+    IntrusivePtr(T* ptr, AdoptRef) noexcept : ptr_(ptr) {}
+
+    // Unique to shared: the object leaves the SimpleUniquePtr with a count of one
+    template<typename TracePolicy>
+    IntrusivePtr(SimpleUniquePtr<T, DefaultDelete<T>, TracePolicy>&& unique) noexcept : IntrusivePtr(unique.release()) {}
+
+    ~IntrusivePtr() {
+        if (ptr_) {
+            ptr_->release();
+        }
+    }
+
+    IntrusivePtr(const IntrusivePtr& other) noexcept : IntrusivePtr(other.ptr_) {}
+
+    IntrusivePtr(IntrusivePtr&& other) noexcept : ptr_(std::exchange(other.ptr_, nullptr)) {}
+
+    IntrusivePtr& operator=(IntrusivePtr other) noexcept { // By value: covers copy and move
+        std::swap(ptr_, other.ptr_);
+        return *this;
+    }
+
+    void reset() noexcept {
+        IntrusivePtr().swap(*this);
+    }
+
+    void swap(IntrusivePtr& other) noexcept {
+        std::swap(ptr_, other.ptr_);
+    }
+
+    // Give up ownership without releasing: the caller now holds the reference
+    T* detach() noexcept {
+        return std::exchange(ptr_, nullptr);
+    }
+
+    T& operator*() const {
+        if (!ptr_) {
+            throw std::runtime_error("Dereferencing a null pointer");
+        }
+        return *ptr_;
+    }
+
+    T* operator->() const {
+        if (!ptr_) {
+            throw std::runtime_error("Dereferencing a null pointer");
+        }
+        return ptr_;
+    }
+
+    T* get() const noexcept {
+        return ptr_;
+    }
+
+    explicit operator bool() const noexcept {
+        return ptr_ != nullptr;
+    }
+};
+
+template<typename T, typename... Args>
+IntrusivePtr<T> make_intrusive(Args&&... args) {
+    return IntrusivePtr<T>(new T(std::forward<Args>(args)...));
+}
+
+// Resource-sized graph node for intrusive sharing: the count adds 4 bytes, not a control block
+struct GraphNode : RefCounted<GraphNode> {
+    int value;
+
+    explicit GraphNode(int v) : value(v) {}
+};
+
+static_assert(sizeof(GraphNode) == 8);
+static_assert(sizeof(IntrusivePtr<GraphNode>) == sizeof(GraphNode*));
+
+// Epoch-based reclamation for lock-free readers of SimpleUniquePtr-owned nodes (RCU style).
+// Readers pin the domain with a Guard for as long as they hold raw pointers into the
+// structure; pinning is two stores and never blocks. A writer unlinks a node (e.g. swaps an
+// atomic pointer) and hands its old owner to retire() instead of deleting it. A background
+// thread advances the global epoch once every pinned reader has seen the current one, and
+// frees nodes retired two epochs ago: no reader can still reach them.
+// Pinned (the reclaim thread and per-thread records point into it). It must outlive every
+// thread that uses it; nodes still waiting at destruction are freed then.
+class EpochDomain {
+private:
+    struct Retired {
+        void* object;
+        void (*reclaim)(void*);
+        std::uint64_t epoch; // Global epoch when it was retired
+    };
+
+    // One per thread that used this domain, kept until the domain dies
+    struct alignas(64) ThreadRecord {
+        std::atomic<std::uint64_t> epoch{0}; // (epoch << 1) | 1 while pinned, 0 otherwise
+        unsigned depth = 0; // Guard nesting, touched by the owning thread only
+        std::mutex mutex; // Owner appends, reclaimer drains
+        std::vector<Retired> retired;
+    };
+
+    struct ThreadSlot {
+        std::uint64_t domain_id;
+        ThreadRecord* record;
+    };
+
+    static inline std::atomic<std::uint64_t> next_id_{1};
+    const std::uint64_t id_ = next_id_.fetch_add(1, std::memory_order_relaxed); // Never reused, unlike addresses
+    std::atomic<std::uint64_t> global_epoch_{2};
+    std::atomic<std::size_t> pending_{0};
+    std::size_t wake_threshold_;
+    std::chrono::milliseconds interval_;
+    std::mutex registry_mutex_; // Guards records_ and epoch advancement
+    std::vector<std::unique_ptr<ThreadRecord>> records_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+    std::thread reclaimer_; // Last member: starts after everything above exists
+
+    ThreadRecord& record() {
+        thread_local std::vector<ThreadSlot> slots;
+        for (const ThreadSlot& slot : slots) {
+            if (slot.domain_id == id_) {
+                return *slot.record;
+            }
+        }
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        records_.push_back(std::make_unique<ThreadRecord>());
+        slots.push_back(ThreadSlot{id_, records_.back().get()});
+        return *records_.back();
+    }
+
+    // Advance the epoch if every pinned reader is in the current one. Caller holds registry_mutex_.
+    void try_advance() {
+        const std::uint64_t current = global_epoch_.load(std::memory_order_seq_cst);
+        for (const auto& rec : records_) {
+            const std::uint64_t e = rec->epoch.load(std::memory_order_seq_cst);
+            if ((e & 1) != 0 && (e >> 1) != current) {
+                return; // A reader is still in an older epoch
+            }
+        }
+        global_epoch_.store(current + 1, std::memory_order_seq_cst);
+    }
+
+    void run_reclaimer() {
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        while (!stop_) {
+            wake_.wait_for(lock, interval_);
+            lock.unlock();
+            reclaim();
+            lock.lock();
+        }
+    }
+
+public:
+    // Reader-side critical section; raw pointers loaded inside stay valid until it ends. Nests.
+    class Guard {
+    private:
+        ThreadRecord* record_;
+
+    public:
+        explicit Guard(EpochDomain& domain) : record_(&domain.record()) {
+            if (record_->depth++ == 0) {
+                const std::uint64_t epoch = domain.global_epoch_.load(std::memory_order_relaxed);
+                record_->epoch.store((epoch << 1) | 1, std::memory_order_seq_cst); // Visible before any load it protects
+            }
+        }
+
+        ~Guard() {
+            if (--record_->depth == 0) {
+                record_->epoch.store(0, std::memory_order_release);
+            }
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        Guard(Guard&&) = delete;
+        Guard& operator=(Guard&&) = delete;
+    };
+
+    // The reclaim thread runs every 'interval', or sooner once 'wake_threshold' nodes are pending
+    explicit EpochDomain(std::chrono::milliseconds interval = std::chrono::milliseconds(1), std::size_t wake_threshold = 1024)
+        : wake_threshold_(wake_threshold), interval_(interval), reclaimer_([this] { run_reclaimer(); }) {}
+
+    ~EpochDomain() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_one();
+        reclaimer_.join();
+        for (const auto& rec : records_) { // No readers are left: free everything
+            for (const Retired& r : rec->retired) {
+                r.reclaim(r.object);
+            }
+        }
+    }
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+    EpochDomain(EpochDomain&&) = delete;
+    EpochDomain& operator=(EpochDomain&&) = delete;
+
+    [[nodiscard]] Guard pin() {
+        return Guard(*this);
+    }
+
+    // Defer destruction of an unlinked node until no reader can hold it. The pointer's deleter
+    // runs on the reclaim thread (or in the domain destructor).
+    template<typename T, typename Deleter, typename TracePolicy>
+    void retire(SimpleUniquePtr<T, Deleter, TracePolicy>&& owner) {
+        using Owner = SimpleUniquePtr<T, Deleter, TracePolicy>;
+        if (!owner) {
+            return;
+        }
+        ThreadRecord& rec = record();
+        {
+            std::lock_guard<std::mutex> lock(rec.mutex);
+            if (rec.retired.size() == rec.retired.capacity()) { // Anything that throws happens before ownership moves
+                rec.retired.reserve(std::max<std::size_t>(64, 2 * rec.retired.capacity()));
+            }
+            Retired entry{};
+            if constexpr (std::is_empty_v<Deleter> && std::is_default_constructible_v<Deleter>) {
+                entry.object = owner.release(); // The deleter can be recreated: keep just the pointer
+                entry.reclaim = [](void* object) { Deleter()(static_cast<T*>(object)); };
+            } else {
+                entry.object = new Owner(std::move(owner)); // Keep the stateful deleter with it
+                entry.reclaim = [](void* holder) { delete static_cast<Owner*>(holder); };
+            }
+            entry.epoch = global_epoch_.load(std::memory_order_seq_cst); // After the caller's unlink
+            rec.retired.push_back(entry);
+        }
+        if (pending_.fetch_add(1, std::memory_order_relaxed) + 1 >= wake_threshold_) {
+            wake_.notify_one();
+        }
+    }
+
+    // Try to advance the epoch and free what is safe now; returns the number of nodes freed
+    std::size_t reclaim() {
+        std::vector<Retired> ready;
+        {
+            std::lock_guard<std::mutex> registry(registry_mutex_);
+            try_advance();
+            const std::uint64_t epoch = global_epoch_.load(std::memory_order_seq_cst);
+            for (const auto& rec : records_) {
+                std::lock_guard<std::mutex> lock(rec->mutex);
+                const auto safe = std::stable_partition(rec->retired.begin(), rec->retired.end(),
+                                                        [epoch](const Retired& r) { return r.epoch + 2 > epoch; });
+                ready.insert(ready.end(), safe, rec->retired.end());
+                rec->retired.erase(safe, rec->retired.end());
+            }
+        }
+        for (const Retired& r : ready) { // Outside the locks: deleters may retire more nodes
+            r.reclaim(r.object);
+        }
+        pending_.fetch_sub(ready.size(), std::memory_order_relaxed);
+        return ready.size();
+    }
+
+    // Nodes retired but not yet freed
+    std::size_t pending() const noexcept {
+        return pending_.load(std::memory_order_relaxed);
+    }
+};
+
+// Tuning for HazardDomain scans. A scan costs one pass over every hazard slot, so retired
+// nodes are batched: the domain scans once retired_ reaches the larger of retire_threshold and
+// scan_factor per hazard slot, which keeps the cost per retire constant as readers come and go.
+struct HazardDomainOptions {
+    std::size_t retire_threshold = 64;
+    std::size_t scan_factor = 2;
+};
+
+// Hazard-pointer reclamation: a reader publishes the pointer it is about to use in a hazard
+// slot, and a retired node is only freed by a scan that finds it in no slot. Unlike
+// EpochDomain, a stalled reader pins just the one node it holds, so memory stays bounded
+// (at most one batch plus one node per slot). Slots are pooled and reused by later guards.
+// Pinned: guards point into it. It must outlive its guards and every AtomicUniquePtr using it.
+class HazardDomain {
+private:
+    struct alignas(64) HazardSlot {
+        std::atomic<const void*> hazard{nullptr};
+        std::atomic<bool> owned{false}; // Held by a Guard
+        HazardSlot* next = nullptr; // Immutable once the slot is published
+    };
+
+    struct Retired {
+        void* object;
+        void (*reclaim)(void*);
+        const void* address; // What readers publish
+    };
+
+    struct SlotCache {
+        std::uint64_t domain_id;
+        HazardSlot* slot;
+    };
+
+    static inline std::atomic<std::uint64_t> next_id_{1};
+    const std::uint64_t id_ = next_id_.fetch_add(1, std::memory_order_relaxed);
+    HazardDomainOptions options_;
+    std::atomic<HazardSlot*> slots_{nullptr}; // Lock-free push-only list
+    std::atomic<std::size_t> slot_count_{0};
+    std::mutex retire_mutex_; // Writers only; readers never take it
+    std::vector<Retired> retired_;
+
+    // Prefer the slot this thread used last, then any free one, else publish a new one
+    HazardSlot* acquire_slot() {
+        thread_local std::vector<SlotCache> cache;
+        auto try_own = [](HazardSlot* slot) {
+            bool expected = false;
+            return !slot->owned.load(std::memory_order_relaxed) &&
+                   slot->owned.compare_exchange_strong(expected, true, std::memory_order_acquire);
+        };
+        auto remember = [this](HazardSlot* slot) {
+            for (SlotCache& entry : cache) {
+                if (entry.domain_id == id_) {
+                    entry.slot = slot;
+                    return slot;
+                }
+            }
+            cache.push_back(SlotCache{id_, slot});
+            return slot;
+        };
+        for (const SlotCache& entry : cache) {
+            if (entry.domain_id == id_ && try_own(entry.slot)) {
+                return entry.slot;
+            }
+        }
+        for (HazardSlot* slot = slots_.load(std::memory_order_acquire); slot; slot = slot->next) {
+            if (try_own(slot)) {
+                return remember(slot);
+            }
+        }
+        auto* slot = new HazardSlot;
+        slot->owned.store(true, std::memory_order_relaxed);
+        slot->next = slots_.load(std::memory_order_relaxed);
+        while (!slots_.compare_exchange_weak(slot->next, slot, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        slot_count_.fetch_add(1, std::memory_order_relaxed);
+        return remember(slot);
+    }
+
+    // Free every retired node no slot points at. Caller holds retire_mutex_.
+    void scan() {
+        std::vector<const void*> hazards;
+        hazards.reserve(slot_count_.load(std::memory_order_relaxed));
+        std::atomic_thread_fence(std::memory_order_seq_cst); // Unlinks happen before reading the slots
+        for (HazardSlot* slot = slots_.load(std::memory_order_acquire); slot; slot = slot->next) {
+            if (const void* p = slot->hazard.load(std::memory_order_seq_cst)) {
+                hazards.push_back(p);
+            }
+        }
+        std::sort(hazards.begin(), hazards.end());
+        const auto keep = std::partition(retired_.begin(), retired_.end(), [&hazards](const Retired& r) {
+            return std::binary_search(hazards.begin(), hazards.end(), r.address);
+        });
+        for (auto it = keep; it != retired_.end(); ++it) {
+            it->reclaim(it->object);
+        }
+        retired_.erase(keep, retired_.end());
+    }
+
+public:
+    // Reader handle: the protected object cannot be freed until the guard goes away
+    template<typename T>
+    class Guard {
+    private:
+        HazardSlot* slot_;
+        T* ptr_;
+
+    public:
+        Guard(HazardSlot* slot, T* ptr) noexcept : slot_(slot), ptr_(ptr) {}
+
+        ~Guard() {
+            slot_->hazard.store(nullptr, std::memory_order_release);
+            slot_->owned.store(false, std::memory_order_release);
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        Guard(Guard&&) = delete;
+        Guard& operator=(Guard&&) = delete;
+
+        T* get() const noexcept { return ptr_; }
+
+        T& operator*() const {
+            if (!ptr_) {
+                throw std::runtime_error("Dereferencing a null pointer");
+            }
+            return *ptr_;
+        }
+
+        T* operator->() const {
+            if (!ptr_) {
+                throw std::runtime_error("Dereferencing a null pointer");
+            }
+            return ptr_;
+        }
+
+        explicit operator bool() const noexcept { return ptr_ != nullptr; }
+    };
+
+    explicit HazardDomain(HazardDomainOptions options = {}) : options_(options) {}
+
+    ~HazardDomain() {
+        for (const Retired& r : retired_) { // No readers are left
+            r.reclaim(r.object);
+        }
+        for (HazardSlot* slot = slots_.load(std::memory_order_relaxed); slot;) {
+            HazardSlot* next = slot->next;
+            delete slot;
+            slot = next;
+        }
+    }
+
+    HazardDomain(const HazardDomain&) = delete;
+    HazardDomain& operator=(const HazardDomain&) = delete;
+    HazardDomain(HazardDomain&&) = delete;
+    HazardDomain& operator=(HazardDomain&&) = delete;
+
+    // Load 'source' and keep the object it points to alive for the guard's lifetime. Lock-free:
+    // retries only while writers keep changing the pointer.
+    template<typename T>
+    [[nodiscard]] Guard<T> protect(const std::atomic<T*>& source) {
+        HazardSlot* slot = acquire_slot();
+        T* ptr = source.load(std::memory_order_relaxed);
+        for (;;) {
+            slot->hazard.store(ptr, std::memory_order_seq_cst);
+            T* again = source.load(std::memory_order_seq_cst); // Still published after the hazard is visible?
+            if (again == ptr) {
+                return Guard<T>(slot, ptr);
+            }
+            ptr = again;
+        }
+    }
+
+    // Hand over an object already unlinked from every shared pointer; it is freed by the first
+    // scan that finds no reader holding it
+    template<typename T, typename Deleter, typename TracePolicy>
+    void retire(SimpleUniquePtr<T, Deleter, TracePolicy>&& owner) {
+        using Owner = SimpleUniquePtr<T, Deleter, TracePolicy>;
+        if (!owner) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(retire_mutex_);
+        if (retired_.size() == retired_.capacity()) { // Anything that throws happens before ownership moves
+            retired_.reserve(std::max<std::size_t>(64, 2 * retired_.capacity()));
+        }
+        Retired entry{};
+        entry.address = owner.get();
+        if constexpr (std::is_empty_v<Deleter> && std::is_default_constructible_v<Deleter>) {
+            entry.object = owner.release();
+            entry.reclaim = [](void* object) { Deleter()(static_cast<T*>(object)); };
+        } else {
+            entry.object = new Owner(std::move(owner));
+            entry.reclaim = [](void* holder) { delete static_cast<Owner*>(holder); };
+        }
+        retired_.push_back(entry);
+        const std::size_t batch = std::max(options_.retire_threshold,
+                                           options_.scan_factor * slot_count_.load(std::memory_order_relaxed));
+        if (retired_.size() >= batch) {
+            scan();
+        }
+    }
+
+    // Scan now instead of waiting for a full batch
+    void reclaim() {
+        std::lock_guard<std::mutex> lock(retire_mutex_);
+        scan();
+    }
+
+    std::size_t pending() {
+        std::lock_guard<std::mutex> lock(retire_mutex_);
+        return retired_.size();
+    }
+};
+
+// Shared, atomically replaceable owner (e.g. a routing table swapped while queries run).
+// Readers call load() for a hazard guard - no locks, no reference counts. Writers install a
+// new SimpleUniquePtr with exchange() or compare_exchange(); the previous object is retired
+// to the HazardDomain rather than returned, since readers may still be using it.
+template<typename T>
+class AtomicUniquePtr {
+private:
+    HazardDomain& domain_;
+    std::atomic<T*> ptr_;
+
+    void retire(T* old) {
+        if (old) {
+            domain_.retire(SimpleUniquePtr<T>(old));
+        }
+    }
+
+public:
+    explicit AtomicUniquePtr(HazardDomain& domain, SimpleUniquePtr<T> initial = SimpleUniquePtr<T>())
+        : domain_(domain), ptr_(initial.release()) {}
+
+    ~AtomicUniquePtr() {
+        retire(ptr_.load(std::memory_order_acquire)); // Late readers may still hold it
+    }
+
+    AtomicUniquePtr(const AtomicUniquePtr&) = delete;
+    AtomicUniquePtr& operator=(const AtomicUniquePtr&) = delete;
+    AtomicUniquePtr(AtomicUniquePtr&&) = delete;
+    AtomicUniquePtr& operator=(AtomicUniquePtr&&) = delete;
+
+    [[nodiscard]] HazardDomain::Guard<T> load() const {
+        return domain_.protect(ptr_);
+    }
+
+    // Install 'desired' and retire the previous object
+    void exchange(SimpleUniquePtr<T> desired) {
+        retire(ptr_.exchange(desired.release(), std::memory_order_acq_rel));
+    }
+
+    // Install 'desired' only if the current object is still 'expected' (compare by address).
+    // On success 'desired' is consumed and the old object retired; on failure 'desired' keeps
+    // its object and 'expected' is updated to the current one.
+    bool compare_exchange(T*& expected, SimpleUniquePtr<T>& desired) {
+        if (ptr_.compare_exchange_strong(expected, desired.get(), std::memory_order_acq_rel, std::memory_order_acquire)) {
+            desired.release();
+            retire(expected);
+            return true;
+        }
+        return false;
+    }
+};
+
+inline constexpr std::size_t kDefaultSboSize = 48; // With the pointer and ops, one 64-byte cache line
+
+// Polymorphic owner with a small buffer: a Derived that fits in N bytes (and moves without
+// throwing) lives inside the box, anything else spills to the heap. Move-only like
+// SimpleUniquePtr, but a std::vector of boxes keeps small objects contiguous instead of
+// chasing one heap pointer per element. No release(): an inline object has no heap block to
+// hand out.
+template<typename Base, std::size_t N = kDefaultSboSize>
+class SboBox {
+private:
+    // Per-Derived operations, so Base needs no virtual destructor or clone()
+    struct Ops {
+        void (*destroy)(Base*) noexcept;
+        Base* (*relocate)(Base* from, void* to) noexcept; // nullptr when heap-allocated
+    };
+
+    template<typename D>
+    static constexpr Ops inline_ops{
+        [](Base* p) noexcept { static_cast<D*>(p)->~D(); },
+        [](Base* from, void* to) noexcept -> Base* {
+            D* source = static_cast<D*>(from);
+            Base* moved = ::new (to) D(std::move(*source));
+            source->~D();
+            return moved;
+        }};
+
+    template<typename D>
+    static constexpr Ops heap_ops{[](Base* p) noexcept { DefaultDelete<D>()(static_cast<D*>(p)); }, nullptr};
+
+    alignas(std::max_align_t) std::byte buffer_[N];
+    Base* ptr_ = nullptr; // Into buffer_ or the heap; may differ from the Derived address
+    const Ops* ops_ = nullptr;
+
+    void steal(SboBox& other) noexcept {
+        if (!other.ptr_) {
+            return;
+        }
+        ptr_ = other.ops_->relocate ? other.ops_->relocate(other.ptr_, buffer_) : other.ptr_;
+        ops_ = other.ops_;
+        other.ptr_ = nullptr;
+        other.ops_ = nullptr;
+    }
+
+public:
+    template<typename D>
+    static constexpr bool fits_inline = sizeof(D) <= N && alignof(D) <= alignof(std::max_align_t) &&
+                                        std::is_nothrow_move_constructible_v<D>;
+
+    SboBox() noexcept = default;
+
+    template<typename D, typename... Args>
+    explicit SboBox(std::in_place_type_t<D>, Args&&... args) {
+        static_assert(std::is_base_of_v<Base, D>, "SboBox holds types derived from Base");
+        if constexpr (fits_inline<D>) {
+            ptr_ = ::new (static_cast<void*>(buffer_)) D(std::forward<Args>(args)...);
+            ops_ = &inline_ops<D>;
+        } else {
+            ptr_ = new D(std::forward<Args>(args)...);
+            ops_ = &heap_ops<D>;
+        }
+    }
+
+    // Adopt an existing heap object; it stays on the heap
+    template<typename D, typename TracePolicy>
+    SboBox(SimpleUniquePtr<D, DefaultDelete<D>, TracePolicy>&& owner) noexcept
+        : ptr_(owner.release()), ops_(ptr_ ? &heap_ops<D> : nullptr) {}
+
+    ~SboBox() { reset(); }
+
+    SboBox(const SboBox&) = delete;
+    SboBox& operator=(const SboBox&) = delete;
+
+    SboBox(SboBox&& other) noexcept { steal(other); }
+
+    SboBox& operator=(SboBox&& other) noexcept {
+        if (this != &other) {
+            reset();
+            steal(other);
         }
         return *this;
     }
-    
-    // TODO: Dereference operators
-    T& operator*() const {
-        // Your implementation here
+
+    void reset() noexcept {
+        if (ptr_) {
+            ops_->destroy(ptr_);
+            ptr_ = nullptr;
+            ops_ = nullptr;
+        }
+    }
+
+    Base* get() const noexcept { return ptr_; }
+
+    Base& operator*() const {
         if (!ptr_) {
             throw std::runtime_error("Dereferencing a null pointer");
         }
-        return *ptr_; // Dereference the pointer to access the object
+        return *ptr_;
     }
-    
-    T* operator->() const {
-        // Your implementation here'
+
+    Base* operator->() const {
         if (!ptr_) {
             throw std::runtime_error("Dereferencing a null pointer");
         }
-        return ptr_; // Return the raw pointer to access the object's members
-    }
-    
-    // TODO: Get raw pointer
-    T* get() const {
-        // Your implementation here
-        return ptr_; // Return the raw pointer to the managed object
+        return ptr_;
     }
-    
-    // TODO: Release ownership
-    T* release() {
-        // Your implementation here
-        T* temp = ptr_; // Store the current pointer
-        ptr_ = nullptr; // Leave the pointer in a null state
-        std::cout << "🔓 SimpleUniquePtr::Release - Released ownership of pointer " << temp << " (caller now owns it)\n";
-        return temp; // Return the raw pointer, transferring ownership
+
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+    bool is_inline() const noexcept { return ptr_ && ops_->relocate; }
+};
+
+static_assert(sizeof(SboBox<Resource>) == 64);
+
+template<typename Base, typename Derived, std::size_t N = kDefaultSboSize, typename... Args>
+SboBox<Base, N> make_sbo_box(Args&&... args) {
+    return SboBox<Base, N>(std::in_place_type<Derived>, std::forward<Args>(args)...);
+}
+
+// Per-type recycling cache for objects created and destroyed in tight loops: a destroyed T's
+// storage stays in its thread's free list and the next T is constructed in it, skipping the
+// global allocator. Each block remembers the cache it came from; a block freed on another
+// thread goes onto that cache's lock-free return queue, which the owner drains when its own
+// list runs dry. Caches outlive their threads - an exiting thread parks its cache and the next
+// new thread adopts it - so a late return never races with teardown. Each cache keeps at most
+// kMaxCached free blocks plus kMaxCached queued returns (an approximate count, checked on the
+// return path) and hands the rest back to the global allocator.
+template<typename T>
+class Recycler {
+public:
+    static constexpr std::size_t kMaxCached = 1024;
+
+    // Uninitialized storage for one T
+    static void* allocate() {
+        Cache* cache = local_cache();
+        if (cache && !cache->free) {
+            cache->drain_returned();
+        }
+        if (cache && cache->free) {
+            Block* block = cache->free;
+            cache->free = block->next;
+            --cache->size;
+            return block->storage;
+        }
+        auto* block = new Block;
+        block->owner = cache; // nullptr during thread teardown: the block is simply deleted later
+        return block->storage;
     }
-    
-    // TODO: Reset with new pointer
-    void reset(T* ptr = nullptr) {
-        // Your implementation 
-        if (ptr_) {
-            std::cout << "🔄 SimpleUniquePtr::Reset - Deleting old pointer " << ptr_ << " (old resource will be destroyed)\n";
-            delete ptr_; // Delete the current object
+
+    // Give back storage whose T has already been destroyed; any thread may call this
+    static void deallocate(void* p) noexcept {
+        Block* block = reinterpret_cast<Block*>(static_cast<std::byte*>(p) - offsetof(Block, storage));
+        if (!block->owner) {
+            delete block;
+        } else if (block->owner == current()) {
+            block->owner->keep(block);
         } else {
-            std::cout << "🔄 SimpleUniquePtr::Reset - No old resource to delete\n";
+            block->owner->give_back(block);
         }
-        ptr_ = ptr; // Take ownership of the new pointer
-        if (ptr_) {
-            std::cout << "🔄 SimpleUniquePtr::Reset - Now managing new pointer " << ptr_ << " (new resource acquired)\n";
-        } else {
-            std::cout << "🔄 SimpleUniquePtr::Reset - Reset to nullptr (no resource)\n"; 
+    }
+
+private:
+    struct Cache;
+
+    struct Block {
+        Cache* owner;
+        Block* next;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    struct Cache {
+        Block* free = nullptr; // Owner thread only
+        std::size_t size = 0;
+        Cache* next_parked = nullptr;
+        alignas(64) std::atomic<Block*> returned{nullptr}; // Pushed by other threads
+        std::atomic<std::size_t> returned_count{0}; // Approximate length of 'returned'
+
+        void keep(Block* block) noexcept {
+            if (size < kMaxCached) {
+                block->next = free;
+                free = block;
+                ++size;
+            } else {
+                delete block;
+            }
+        }
+
+        void give_back(Block* block) noexcept {
+            if (returned_count.fetch_add(1, std::memory_order_relaxed) >= kMaxCached) {
+                returned_count.fetch_sub(1, std::memory_order_relaxed);
+                delete block; // Queue full: an idle or parked owner must not hoard returns
+                return;
+            }
+            block->next = returned.load(std::memory_order_relaxed);
+            while (!returned.compare_exchange_weak(block->next, block, std::memory_order_release,
+                                                   std::memory_order_relaxed)) {
+            }
+        }
+
+        // Single consumer takes the whole queue at once, so there is no ABA on pop
+        void drain_returned() noexcept {
+            std::size_t drained = 0;
+            for (Block* block = returned.exchange(nullptr, std::memory_order_acquire); block; ++drained) {
+                Block* next = block->next;
+                keep(block);
+                block = next;
+            }
+            returned_count.fetch_sub(drained, std::memory_order_relaxed);
+        }
+    };
+
+    struct Parked {
+        std::mutex mutex;
+        Cache* head = nullptr;
+    };
+
+    // Registers this thread's cache on first use and parks it at thread exit
+    struct Handle {
+        Cache* cache;
+
+        Handle() {
+            Parked& parked = parked_caches();
+            std::lock_guard<std::mutex> lock(parked.mutex);
+            if (parked.head) {
+                cache = parked.head;
+                parked.head = cache->next_parked;
+            } else {
+                cache = new Cache;
+            }
         }
+
+        ~Handle() {
+            current() = nullptr;
+            exited() = true;
+            Parked& parked = parked_caches();
+            std::lock_guard<std::mutex> lock(parked.mutex);
+            cache->next_parked = parked.head;
+            parked.head = cache;
+        }
+
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+    };
+
+    static Parked& parked_caches() {
+        static Parked parked;
+        return parked;
     }
-    
-    // TODO: Check if pointer is valid
-    explicit operator bool() const {
-        // Your implementation here
-        return ptr_ != nullptr; // Return true if the pointer is not null
+
+    static Cache*& current() noexcept {
+        thread_local Cache* cache = nullptr;
+        return cache;
+    }
+
+    // Trivially destructible, so still readable from thread_local destructors that run after ours
+    static bool& exited() noexcept {
+        thread_local bool flag = false;
+        return flag;
+    }
+
+    // nullptr once this thread's cache has been parked
+    static Cache* local_cache() {
+        Cache*& cache = current();
+        if (!cache && !exited()) {
+            thread_local Handle handle;
+            cache = handle.cache;
+        }
+        return cache;
     }
 };
 
-// TODO: Implement make_simple_unique helper function
-template<typename T, typename... Args>
-SimpleUniquePtr<T> make_simple_unique(Args&&... args) 
+// CRTP opt-in: 'struct Order : Recyclable<Order>' makes every 'new Order' - including the one
+// inside make_simple_unique - draw from Recycler<Order>, and DefaultDelete's 'delete' return to
+// it. Derived classes of a different size fall through to the global allocator.
+template<typename T>
+struct Recyclable {
+    static void* operator new(std::size_t size) {
+        return size == sizeof(T) ? Recycler<T>::allocate() : ::operator new(size);
+    }
 
-{
-    // This function creates a SimpleUniquePtr by allocating a new object of type T
-    // and forwarding the arguments to its constructor
-    return SimpleUniquePtr<T>(new T(std::forward<Args>(args)...));
-}
+    static void operator delete(void* p, std::size_t size) noexcept {
+        if (size == sizeof(T)) {
+            Recycler<T>::deallocate(p);
+        } else {
+            ::operator delete(p, size);
+        }
+    }
+};
 
 // Test functions
 void test_move_semantics() {
     std::cout << "=== RAII Kata #2: Smart Pointers and Move Semantics ===\n";
+    using TracedPtr = SimpleUniquePtr<Resource, DefaultDelete<Resource>, VerboseTrace>; // Narrate every ownership change
     
     // Test 1: Basic usage
     {
         std::cout << "\n--- Test 1: Basic Usage ---\n";
         std::cout << "📝 Creating SimpleUniquePtr with Resource(42)...\n";
-        SimpleUniquePtr<Resource> ptr(new Resource(42));
+        TracedPtr ptr(new Resource(42));
         std::cout << "📖 Accessing resource value through smart pointer...\n";
         std::cout << "Resource value: " << ptr->getValue() << std::endl;
         std::cout << "📝 Leaving scope - smart pointer should automatically clean up...\n";
@@ -193,9 +2194,9 @@ void test_move_semantics() {
     {
         std::cout << "\n--- Test 2: Move Constructor ---\n";
         std::cout << "📝 Creating first smart pointer...\n";
-        SimpleUniquePtr<Resource> ptr1(new Resource(100));
+        TracedPtr ptr1(new Resource(100));
         std::cout << "📝 Moving ptr1 to ptr2 using move constructor...\n";
-        SimpleUniquePtr<Resource> ptr2 = std::move(ptr1);
+        TracedPtr ptr2 = std::move(ptr1);
         
         std::cout << "📊 After move constructor:\n";
         std::cout << "ptr1 is " << (ptr1 ? "valid" : "null") << " (should be null - ownership transferred)\n";
@@ -211,8 +2212,8 @@ void test_move_semantics() {
     {
         std::cout << "\n--- Test 3: Move Assignment ---\n";
         std::cout << "📝 Creating two smart pointers with different resources...\n";
-        SimpleUniquePtr<Resource> ptr1(new Resource(200));
-        SimpleUniquePtr<Resource> ptr2(new Resource(300));
+        TracedPtr ptr1(new Resource(200));
+        TracedPtr ptr2(new Resource(300));
         
         std::cout << "📊 Before move assignment:\n";
         std::cout << "ptr1 value: " << ptr1->getValue() << " (will be moved)\n";
@@ -234,7 +2235,7 @@ void test_move_semantics() {
     {
         std::cout << "\n--- Test 4: make_simple_unique ---\n";
         std::cout << "📝 Creating smart pointer using make_simple_unique helper...\n";
-        auto ptr = make_simple_unique<Resource>(500);
+        auto ptr = make_simple_unique<Resource, VerboseTrace>(500);
         std::cout << "📖 Created resource with value: " << ptr->getValue() << std::endl;
         std::cout << "📝 Leaving scope - make_simple_unique result should clean up...\n";
     }
@@ -244,11 +2245,11 @@ void test_move_semantics() {
     {
         std::cout << "\n--- Test 5: Container Usage ---\n";
         std::cout << "📝 Creating vector of move-only smart pointers...\n";
-        std::vector<SimpleUniquePtr<Resource>> resources;
+        std::vector<TracedPtr> resources;
         
         for (int i = 0; i < 3; ++i) {
             std::cout << "📝 Adding resource " << i << " to container...\n";
-            resources.push_back(make_simple_unique<Resource>(i * 10));
+            resources.push_back(make_simple_unique<Resource, VerboseTrace>(i * 10));
         }
         
         std::cout << "📊 Resources in container:\n";
@@ -259,10 +2260,734 @@ void test_move_semantics() {
     } // All resources should be destroyed when vector is destroyed
     std::cout << "✅ Test 5 completed - Container correctly managed move-only objects!\n";
     
+    // Test 6: Custom deleters and allocator-aware creation
+    {
+        std::cout << "\n--- Test 6: Custom Deleters ---\n";
+        int deleted = 0;
+        const auto counting_delete = [&deleted](Resource* ptr) { ++deleted; delete ptr; }; // Stateful: captures a reference
+        {
+            std::cout << "📝 Creating smart pointer with a stateful deleter...\n";
+            SimpleUniquePtr<Resource, decltype(counting_delete)> ptr(new Resource(600), counting_delete);
+            SimpleUniquePtr<Resource, decltype(counting_delete)> moved = std::move(ptr); // Deleter moves with the pointer
+            std::cout << "📊 Size with a stateful deleter: " << sizeof(moved) << " bytes (pointer + deleter state)\n";
+        }
+        if (deleted != 1) {
+            throw std::runtime_error("Stateful deleter did not run exactly once");
+        }
+
+        std::cout << "📝 Creating smart pointer in a monotonic arena with allocate_simple_unique...\n";
+        std::array<std::byte, 256> storage{};
+        std::pmr::monotonic_buffer_resource arena(storage.data(), storage.size());
+        {
+            auto ptr = allocate_simple_unique<Resource>(std::pmr::polymorphic_allocator<Resource>(&arena), 700);
+            const auto* address = reinterpret_cast<const std::byte*>(ptr.get());
+            if (address < storage.data() || address >= storage.data() + storage.size()) {
+                throw std::runtime_error("allocate_simple_unique did not use the allocator");
+            }
+            std::cout << "📖 Arena resource value: " << ptr->getValue() << ", pointer size " << sizeof(ptr) << " bytes\n";
+        } // Destroyed through the allocator; the arena memory is reclaimed with 'arena'
+        std::cout << "📊 Size with std::allocator: " << sizeof(allocate_simple_unique<int>(std::allocator<int>(), 1))
+                  << " bytes (empty deleter takes no space)\n";
+    }
+    std::cout << "✅ Test 6 completed - Custom deleters freed their resources!\n";
+
+    // Test 7: Arrays
+    {
+        std::cout << "\n--- Test 7: Arrays ---\n";
+        std::cout << "📝 Creating SimpleUniquePtr<Resource[]> - every element must be destroyed by delete[]...\n";
+        SimpleUniquePtr<Resource[]> resources(new Resource[2]{Resource(1), Resource(2)});
+        resources[1].setValue(3);
+        std::cout << "📖 Element values: " << resources[0].getValue() << ", " << resources[1].getValue() << std::endl;
+
+        auto zeros = make_simple_unique<int[]>(4); // Value-initialized
+        auto scratch = make_simple_unique_for_overwrite<int[]>(4); // Left uninitialized
+        for (std::size_t i = 0; i < 4; ++i) {
+            scratch[i] = static_cast<int>(i);
+            if (zeros[i] != 0) {
+                throw std::runtime_error("make_simple_unique<T[]> did not value-initialize");
+            }
+        }
+        std::cout << "📖 Scratch buffer after overwrite: " << scratch[0] << scratch[1] << scratch[2] << scratch[3] << std::endl;
+        std::cout << "📝 Leaving scope - delete[] destroys both Resources...\n";
+    }
+    std::cout << "✅ Test 7 completed - Arrays were freed with delete[]!\n";
+
+    // Test 8: Pooled allocation
+    {
+        std::cout << "\n--- Test 8: Pooled Allocation ---\n";
+        std::cout << "📝 Creating a Resource in the slab pool with make_pooled_unique...\n";
+        auto pooled = make_pooled_unique<Resource>(800);
+        const void* address = pooled.get();
+        std::cout << "📖 Pooled resource value: " << pooled->getValue() << ", pointer size " << sizeof(pooled) << " bytes\n";
+        pooled.reset(); // Block goes back to this thread's free list...
+        auto again = make_pooled_unique<Resource>(801); // ...and is the first one handed out again
+        std::cout << "📊 Freed block reused: " << (again.get() == address ? "yes" : "no") << "\n";
+
+        std::vector<SimpleUniquePtr<int, PoolDelete<int>>> ints;
+        std::thread producer([&ints] {
+            for (int i = 0; i < 1000; ++i) {
+                ints.push_back(make_pooled_unique<int>(i));
+            }
+        });
+        producer.join();
+        for (int i = 0; i < 1000; ++i) {
+            if (*ints[static_cast<std::size_t>(i)] != i) {
+                throw std::runtime_error("Pooled int lost its value");
+            }
+        }
+        ints.clear(); // Freed on this thread, allocated on the (finished) producer
+        std::cout << "📝 Leaving scope - the pooled Resource is destroyed and its block recycled...\n";
+    }
+    std::cout << "✅ Test 8 completed - Pooled objects were recycled!\n";
+
+    // Test 9: Arena handles
+    {
+        std::cout << "\n--- Test 9: Arena Allocation ---\n";
+        Arena arena(1024);
+        const void* first = nullptr;
+        {
+            std::cout << "📝 Creating a Resource in the arena with make_arena_unique...\n";
+            auto resource = make_arena_unique<Resource>(arena, 900);
+            first = resource.get();
+            auto value = make_arena_unique<double>(arena, 2.5); // Trivially destructible: the deleter is a no-op
+            for (int i = 0; i < 3; ++i) {
+                make_arena_unique<std::array<std::byte, 700>>(arena); // Does not fit: chains new chunks
+            }
+            std::cout << "📊 Chunks after 2.1 KB of allocations: " << arena.chunk_count() << "\n";
+            std::cout << "📝 Leaving scope - handles run destructors but free nothing...\n";
+        }
+        const std::size_t chunks = arena.chunk_count();
+        arena.reset();
+        auto reused = make_arena_unique<Resource>(arena, 901);
+        if (reused.get() != first || arena.chunk_count() != chunks) {
+            throw std::runtime_error("Arena reset did not rewind to the first chunk");
+        }
+        std::cout << "📊 After reset() the first chunk is reused (same address), chunks kept: " << arena.chunk_count() << "\n";
+    }
+    std::cout << "✅ Test 9 completed - Arena handles destroyed their objects and reset() reclaimed the memory!\n";
+
+    // Test 10: Shared and weak ownership
+    {
+        std::cout << "\n--- Test 10: Shared Ownership ---\n";
+        std::cout << "📝 Creating a shared Resource with make_simple_shared (one allocation)...\n";
+        SimpleWeakPtr<Resource> observer;
+        {
+            auto owner = make_simple_shared<Resource>(1000);
+            observer = owner;
+            SimpleSharedPtr<Resource> copy = owner;
+            std::cout << "📊 use_count with two owners: " << owner.use_count() << ", pointer size " << sizeof(owner) << " bytes\n";
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t) {
+                threads.emplace_back([copy] { // Each thread copies and drops the pointer concurrently
+                    for (int i = 0; i < 10000; ++i) {
+                        SimpleSharedPtr<Resource> local = copy;
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            if (owner.use_count() != 2 || observer.lock()->getValue() != 1000) {
+                throw std::runtime_error("Shared counts are wrong after concurrent copies");
+            }
+            std::cout << "📝 Leaving scope - the last owner destroys the Resource...\n";
+        }
+        std::cout << "📊 Weak pointer expired: " << (observer.expired() ? "yes" : "no") << "\n";
+        if (!observer.expired() || observer.lock()) {
+            throw std::runtime_error("Weak pointer outlived the object");
+        }
+        auto local = make_simple_shared<int, NonAtomicCount>(7); // Thread-confined: plain counters
+        auto local_copy = local;
+        std::cout << "📊 Non-atomic use_count: " << local.use_count() << "\n";
+    }
+    std::cout << "✅ Test 10 completed - Shared ownership released the object exactly once!\n";
+
+    // Test 11: Intrusive reference counting
+    {
+        std::cout << "\n--- Test 11: Intrusive Pointers ---\n";
+        std::cout << "📝 Converting a SimpleUniquePtr<GraphNode> into an IntrusivePtr...\n";
+        IntrusivePtr<GraphNode> node = make_simple_unique<GraphNode>(42);
+        IntrusivePtr<GraphNode> retained(node.get()); // Retain: a second owner from the raw pointer
+        std::cout << "📊 ref_count after retain: " << node->ref_count() << ", node size " << sizeof(GraphNode) << " bytes\n";
+        GraphNode* raw = retained.detach(); // Keep the reference while crossing a raw-pointer API...
+        IntrusivePtr<GraphNode> adopted(raw, adopt_ref); // ...and adopt it back without a new increment
+        if (node->ref_count() != 2 || adopted->value != 42) {
+            throw std::runtime_error("Intrusive retain/adopt miscounted");
+        }
+        node.reset();
+        std::cout << "📊 ref_count after one owner resets: " << adopted->ref_count() << "\n";
+    }
+    std::cout << "✅ Test 11 completed - Intrusive counts followed retain and adopt!\n";
+
+    // Test 12: Epoch-based reclamation
+    {
+        std::cout << "\n--- Test 12: Epoch-Based Reclamation ---\n";
+        struct Snapshot {
+            int version;
+            int check; // Always -version while the snapshot is alive
+            explicit Snapshot(int v) : version(v), check(-v) {}
+            ~Snapshot() { check = 1; } // A reader seeing this read freed memory
+        };
+        std::atomic<int> freed{0};
+        const auto counting_delete = [&freed](Snapshot* s) { ++freed; delete s; };
+        {
+            EpochDomain domain;
+            std::atomic<Snapshot*> current{new Snapshot(0)};
+            std::atomic<bool> done{false};
+            std::atomic<bool> corrupt{false};
+            std::atomic<long> reads{0};
+            std::vector<std::thread> readers;
+            for (int t = 0; t < 3; ++t) {
+                readers.emplace_back([&] {
+                    while (!done.load(std::memory_order_relaxed)) {
+                        const auto guard = domain.pin(); // Wait-free: no locks, no counters on the node
+                        const Snapshot* snapshot = current.load(std::memory_order_acquire);
+                        if (snapshot->check != -snapshot->version) {
+                            corrupt = true;
+                        }
+                        reads.fetch_add(1, std::memory_order_relaxed);
+                    }
+                });
+            }
+            std::cout << "📝 Publishing 1000 snapshots while 3 readers traverse them...\n";
+            for (int v = 1; v <= 1000; ++v) {
+                Snapshot* old = current.exchange(new Snapshot(v), std::memory_order_acq_rel); // Unlink...
+                domain.retire(SimpleUniquePtr<Snapshot, decltype(counting_delete)>(old, counting_delete)); // ...then retire
+                std::this_thread::yield(); // Let readers run between updates
+            }
+            done = true;
+            for (auto& reader : readers) {
+                reader.join();
+            }
+            domain.retire(SimpleUniquePtr<Snapshot>(current.exchange(nullptr)));
+            std::cout << "📊 Reads: " << reads.load() << ", snapshots freed so far: " << freed.load() << "\n";
+            std::cout << "📝 Destroying the domain frees whatever is still pending...\n";
+            if (corrupt) {
+                throw std::runtime_error("A reader saw a reclaimed snapshot");
+            }
+        }
+        if (freed.load() != 1000) {
+            throw std::runtime_error("Epoch domain lost retired snapshots");
+        }
+    }
+    std::cout << "✅ Test 12 completed - Retired nodes were freed only after readers moved on!\n";
+
+    // Test 13: Hazard-pointer protected hot swap
+    {
+        std::cout << "\n--- Test 13: Hazard Pointers ---\n";
+        struct RoutingTable {
+            std::vector<int> routes;
+            explicit RoutingTable(int generation) : routes(64, generation) {}
+            ~RoutingTable() { routes.assign(routes.size(), -1); } // A reader seeing this read freed memory
+        };
+        HazardDomain domain(HazardDomainOptions{16, 2});
+        {
+            AtomicUniquePtr<RoutingTable> table(domain, make_simple_unique<RoutingTable>(0));
+            std::atomic<bool> done{false};
+            std::atomic<bool> corrupt{false};
+            std::vector<std::thread> readers;
+            for (int t = 0; t < 3; ++t) {
+                readers.emplace_back([&] {
+                    while (!done.load(std::memory_order_relaxed)) {
+                        const auto guard = table.load(); // No locks on the read side
+                        if (guard->routes.front() < 0 || guard->routes.front() != guard->routes.back()) {
+                            corrupt = true;
+                        }
+                    }
+                });
+            }
+            std::cout << "📝 Hot-swapping the routing table 500 times under 3 readers...\n";
+            for (int generation = 1; generation <= 500; ++generation) {
+                table.exchange(make_simple_unique<RoutingTable>(generation));
+                std::this_thread::yield();
+            }
+            RoutingTable* expected = nullptr; // Stale: the swap must fail and keep 'desired'
+            auto desired = make_simple_unique<RoutingTable>(1000);
+            const bool stale_swapped = table.compare_exchange(expected, desired);
+            const bool fresh_swapped = table.compare_exchange(expected, desired); // 'expected' was refreshed
+            done = true;
+            for (auto& reader : readers) {
+                reader.join();
+            }
+            std::cout << "📊 Nodes waiting for a scan: " << domain.pending() << " (bounded by the batch size)\n";
+            if (corrupt || stale_swapped || !fresh_swapped || desired || table.load()->routes.front() != 1000 ||
+                domain.pending() > 16) {
+                throw std::runtime_error("Hazard-pointer swap misbehaved");
+            }
+        }
+        domain.reclaim();
+        std::cout << "📊 After the final scan: " << domain.pending() << " pending\n";
+    }
+    std::cout << "✅ Test 13 completed - Readers never saw a freed routing table!\n";
+
+    // Test 14: Small-buffer polymorphic box
+    {
+        std::cout << "\n--- Test 14: SboBox ---\n";
+        static int alive = 0;
+        struct Shape {
+            virtual ~Shape() = default;
+            virtual int area() const = 0;
+        };
+        struct Square : Shape {
+            int side;
+            explicit Square(int s) : side(s) { ++alive; }
+            Square(Square&& other) noexcept : side(other.side) { ++alive; }
+            ~Square() override { --alive; }
+            int area() const override { return side * side; }
+        };
+        struct Mesh : Shape { // Too big for the buffer
+            std::array<int, 32> cells{};
+            explicit Mesh(int fill) { cells.fill(fill); ++alive; }
+            ~Mesh() override { --alive; }
+            int area() const override { return std::accumulate(cells.begin(), cells.end(), 0); }
+        };
+        {
+            auto small = make_sbo_box<Shape, Square>(3);
+            auto big = make_sbo_box<Shape, Mesh>(1);
+            std::cout << "📊 Square inline: " << std::boolalpha << small.is_inline() << ", Mesh inline: "
+                      << big.is_inline() << "\n";
+            if (!small.is_inline() || big.is_inline() || small->area() != 9 || big->area() != 32) {
+                throw std::runtime_error("SboBox placed an object in the wrong storage");
+            }
+            std::vector<SboBox<Shape>> shapes;
+            for (int i = 0; i < 100; ++i) { // Growth relocates the inline Squares
+                shapes.push_back(make_sbo_box<Shape, Square>(i));
+            }
+            shapes.push_back(std::move(big));
+            shapes.emplace_back(make_simple_unique<Square>(2)); // Adopted heap object stays on the heap
+            long total = 0;
+            for (const auto& shape : shapes) {
+                total += shape->area();
+            }
+            std::cout << "📝 102 shapes, total area " << total << ", " << alive << " alive\n";
+            if (total != 328350 + 32 + 4 || alive != 103 || big || shapes.back().is_inline()) {
+                throw std::runtime_error("SboBox lost or duplicated an object");
+            }
+        }
+        std::cout << "📊 Alive after scope: " << alive << "\n";
+        if (alive != 0) {
+            throw std::runtime_error("SboBox leaked an object");
+        }
+    }
+    std::cout << "✅ Test 14 completed - Small objects lived inline and every box cleaned up!\n";
+
+    // Test 15: Allocation tracking
+    {
+        std::cout << "\n--- Test 15: Allocation Tracking ---\n";
+        if constexpr (kTrackAllocations) {
+            struct Sample {
+                double reading;
+            };
+            auto kept = make_simple_unique<Sample>(1.0);
+            std::thread worker([] { // Counters from an exited thread must still be reported
+                for (int i = 0; i < 100; ++i) {
+                    auto batch = make_simple_unique<Sample[]>(4);
+                    auto one = make_simple_unique<Sample>(2.0);
+                }
+            });
+            worker.join();
+            {
+                std::vector<SimpleUniquePtr<Sample>> burst; // Each new per-thread high reaches the shared peak
+                for (int i = 0; i < 200; ++i) {
+                    burst.push_back(make_simple_unique<Sample>(4.0));
+                }
+            }
+            auto untracked = SimpleUniquePtr<Sample>(new Sample{3.0}); // Not from make_simple_unique: ignored
+            const auto single = AllocationTracker::stats<Sample>();
+            const auto arrays = AllocationTracker::stats<Sample[]>();
+            std::cout << "📊 " << single.name << ": " << single.allocs << " allocs, " << single.live
+                      << " live, peak " << single.peak_live << "\n";
+            if (single.allocs != 301 || single.frees != 300 || single.live != 1 ||
+                single.peak_live < 201 ||
+                arrays.allocs != 100 || arrays.bytes_allocated != 100 * 4 * sizeof(Sample) || arrays.live != 0) {
+                throw std::runtime_error("AllocationTracker miscounted");
+            }
+            std::cout << "📝 JSON dump:\n";
+            AllocationTracker::dump_json(std::cout);
+        } else {
+            std::cout << "📝 Compiled out - build with -DKATA2_TRACK_ALLOCATIONS=1 to enable\n";
+        }
+    }
+    std::cout << "✅ Test 15 completed - Allocation statistics matched the work done!\n";
+
+    // Test 16: Recycling cache
+    {
+        std::cout << "\n--- Test 16: Recycler ---\n";
+        struct RecycledResource : Resource, Recyclable<RecycledResource> {
+            using Resource::Resource;
+        };
+        const void* first = nullptr;
+        {
+            auto ptr = make_simple_unique<RecycledResource>(7);
+            first = ptr.get();
+        }
+        auto again = make_simple_unique<RecycledResource>(8); // Built in the storage just freed
+        std::cout << "📊 Second object reused the first one's storage: " << std::boolalpha << (again.get() == first) << "\n";
+        if (again.get() != first) {
+            throw std::runtime_error("Recycler did not reuse a freed block");
+        }
+        again.reset();
+
+        struct Token : Recyclable<Token> {
+            int id;
+            explicit Token(int i) : id(i) {}
+        };
+        std::vector<SimpleUniquePtr<Token>> handed_off;
+        std::vector<const void*> addresses;
+        for (int i = 0; i < 100; ++i) {
+            handed_off.push_back(make_simple_unique<Token>(i));
+            addresses.push_back(handed_off.back().get());
+        }
+        std::cout << "📝 Freeing 100 tokens on another thread...\n";
+        std::thread consumer([&handed_off] { handed_off.clear(); }); // Back through the return queue
+        consumer.join();
+        std::size_t reused = 0;
+        std::vector<SimpleUniquePtr<Token>> fresh;
+        for (int i = 0; i < 100; ++i) {
+            fresh.push_back(make_simple_unique<Token>(i));
+            reused += static_cast<std::size_t>(std::count(addresses.begin(), addresses.end(), fresh.back().get()));
+        }
+        std::cout << "📊 Tokens rebuilt in returned storage: " << reused << "/100\n";
+        if (reused != 100) {
+            throw std::runtime_error("Cross-thread returns were not recycled");
+        }
+    }
+    std::cout << "✅ Test 16 completed - Freed storage came back to its owning thread!\n";
+    
     std::cout << "\n🎉 All tests completed successfully!\n";
 }
 
-int main() {
+// Swallows everything written to it, so the verbose tracer's formatting is still paid for
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+// Shift 'slots' pointers one place to the left 'rounds' times: one move construction plus
+// slots move assignments per round. Returns nanoseconds per move.
+template<typename Ptr>
+double time_moves(std::size_t slots, std::size_t rounds) {
+    std::vector<Ptr> ptrs;
+    for (std::size_t i = 0; i < slots; ++i) {
+        ptrs.emplace_back(new int(static_cast<int>(i)));
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t round = 0; round < rounds; ++round) {
+        Ptr first = std::move(ptrs.front());
+        for (std::size_t i = 0; i + 1 < slots; ++i) {
+            ptrs[i] = std::move(ptrs[i + 1]);
+        }
+        ptrs.back() = std::move(first);
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    if (*ptrs.front() != static_cast<int>(rounds % slots)) { // Also keeps the loop observable
+        throw std::runtime_error("Rotation lost a pointer");
+    }
+    return elapsed.count() / static_cast<double>(rounds * (slots + 1));
+}
+
+// Cost of a pointer move with the default (no-op) trace policy, std::unique_ptr and VerboseTrace
+void benchmark_trace_policy() {
+    std::cout << "\n--- Benchmark: move cost by trace policy ---\n";
+    constexpr std::size_t slots = 1024;
+    std::cout << "SimpleUniquePtr<int> (NoTrace): " << time_moves<SimpleUniquePtr<int>>(slots, 20000) << " ns/move\n";
+    std::cout << "std::unique_ptr<int>: " << time_moves<std::unique_ptr<int>>(slots, 20000) << " ns/move\n";
+    NullBuffer null;
+    std::streambuf* const saved = std::cout.rdbuf(&null);
+    const double verbose = time_moves<SimpleUniquePtr<int, DefaultDelete<int>, VerboseTrace>>(slots, 200);
+    std::cout.rdbuf(saved);
+    std::cout << "SimpleUniquePtr<int, VerboseTrace> (to a null stream): " << verbose << " ns/move\n";
+}
+
+// Per-frame sensor buffer: allocate, fill every element, free. Value-initialization zeroes the
+// buffer first; for_overwrite leaves the fill as the only pass over the memory.
+template<typename Make>
+double time_frames(std::size_t elements, std::size_t frames, Make make) {
+    float sum = 0.0f;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t frame = 0; frame < frames; ++frame) {
+        auto buffer = make(elements);
+        std::iota(buffer.get(), buffer.get() + elements, static_cast<float>(frame));
+        sum += buffer[frame % elements];
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    if (sum < 0.0f) { // Keep the buffers observable
+        throw std::runtime_error("Unexpected frame checksum");
+    }
+    return elapsed.count() / static_cast<double>(frames);
+}
+
+void benchmark_for_overwrite() {
+    std::cout << "\n--- Benchmark: make_simple_unique<float[]> vs make_simple_unique_for_overwrite ---\n";
+    for (const std::size_t elements : {std::size_t{1} << 16, std::size_t{1} << 20, std::size_t{1} << 23}) {
+        const double zeroed = time_frames(elements, 50, [](std::size_t n) { return make_simple_unique<float[]>(n); });
+        const double overwrite = time_frames(elements, 50, [](std::size_t n) { return make_simple_unique_for_overwrite<float[]>(n); });
+        std::cout << elements * sizeof(float) / 1024 << " KB frame: value-init " << zeroed << " ms, for_overwrite "
+                  << overwrite << " ms\n";
+    }
+}
+
+// Small, trivially destructible object typical of hot loops
+struct Particle {
+    double x, y, z;
+    int id;
+};
+
+// Each thread keeps 256 live objects and replaces one per operation (free, then a timed
+// allocation). Returns {million allocations/s across all threads, p99 allocation latency in ns};
+// the latency includes the cost of reading the clock.
+template<typename Make>
+std::pair<double, double> churn(unsigned threads, std::size_t ops_per_thread, Make make) {
+    std::vector<std::vector<std::uint32_t>> samples(threads);
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&samples, t, ops_per_thread, make] {
+            std::vector<decltype(make(0))> live(256);
+            std::vector<std::uint32_t>& latency = samples[t];
+            latency.reserve(ops_per_thread);
+            for (std::size_t i = 0; i < ops_per_thread; ++i) {
+                auto& slot = live[i % live.size()];
+                slot.reset();
+                const auto before = std::chrono::steady_clock::now();
+                slot = make(static_cast<int>(i));
+                latency.push_back(static_cast<std::uint32_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - before).count()));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::vector<std::uint32_t> all;
+    for (const auto& s : samples) {
+        all.insert(all.end(), s.begin(), s.end());
+    }
+    const auto p99 = all.begin() + static_cast<std::ptrdiff_t>(all.size() * 99 / 100);
+    std::nth_element(all.begin(), p99, all.end());
+    return {static_cast<double>(all.size()) / elapsed.count() / 1e6, static_cast<double>(*p99)};
+}
+
+// Particle drawn from Recycler<RecycledParticle> by make_simple_unique
+struct RecycledParticle : Particle, Recyclable<RecycledParticle> {
+    RecycledParticle(double px, double py, double pz, int pid) : Particle{px, py, pz, pid} {}
+};
+
+void benchmark_recycler_churn() {
+    std::cout << "\n--- Benchmark: make_simple_unique churn, global new vs Recycler (32-byte objects) ---\n";
+    for (const unsigned threads : {1u, 8u, 32u}) {
+        const auto [global_mops, global_p99] = churn(threads, 100000, [](int i) { return make_simple_unique<Particle>(0.0, 0.0, 0.0, i); });
+        const auto [recycled_mops, recycled_p99] =
+            churn(threads, 100000, [](int i) { return make_simple_unique<RecycledParticle>(0.0, 0.0, 0.0, i); });
+        std::cout << threads << " threads: global new " << global_mops << " M allocs/s (p99 " << global_p99
+                  << " ns), Recycler " << recycled_mops << " M allocs/s (p99 " << recycled_p99 << " ns)\n";
+    }
+}
+
+void benchmark_pooled_allocation() {
+    std::cout << "\n--- Benchmark: make_simple_unique vs make_pooled_unique (32-byte objects) ---\n";
+    for (const unsigned threads : {1u, 2u, 4u, 8u, 16u, 32u}) {
+        const auto [global_mops, global_p99] = churn(threads, 100000, [](int i) { return make_simple_unique<Particle>(0.0, 0.0, 0.0, i); });
+        const auto [pool_mops, pool_p99] = churn(threads, 100000, [](int i) { return make_pooled_unique<Particle>(0.0, 0.0, 0.0, i); });
+        std::cout << threads << " threads: global new " << global_mops << " M allocs/s (p99 " << global_p99
+                  << " ns), pool " << pool_mops << " M allocs/s (p99 " << pool_p99 << " ns)\n";
+    }
+}
+
+// One planning tick: create 100k objects, use them, drop them all. Returns ms per tick.
+template<typename Make, typename EndTick>
+double time_ticks(std::size_t ticks, Make make, EndTick end_tick) {
+    constexpr std::size_t objects = 100000;
+    std::vector<decltype(make(0))> live;
+    live.reserve(objects);
+    double sum = 0.0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t tick = 0; tick < ticks; ++tick) {
+        for (std::size_t i = 0; i < objects; ++i) {
+            live.push_back(make(static_cast<int>(i)));
+        }
+        for (const auto& p : live) {
+            sum += p->x + static_cast<double>(p->id);
+        }
+        live.clear(); // Every handle runs its deleter
+        end_tick();
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    if (sum < 0.0) {
+        throw std::runtime_error("Unexpected tick checksum");
+    }
+    return elapsed.count() / static_cast<double>(ticks);
+}
+
+void benchmark_arena_ticks() {
+    std::cout << "\n--- Benchmark: per-tick allocation of 100k objects ---\n";
+    constexpr std::size_t ticks = 50;
+    const auto nothing = [] {};
+    std::cout << "make_simple_unique: "
+              << time_ticks(ticks, [](int i) { return make_simple_unique<Particle>(1.0, 0.0, 0.0, i); }, nothing) << " ms/tick\n";
+    std::cout << "make_pooled_unique: "
+              << time_ticks(ticks, [](int i) { return make_pooled_unique<Particle>(1.0, 0.0, 0.0, i); }, nothing) << " ms/tick\n";
+    Arena arena(std::size_t{1} << 20);
+    std::cout << "make_arena_unique + reset(): "
+              << time_ticks(ticks, [&arena](int i) { return make_arena_unique<Particle>(arena, 1.0, 0.0, 0.0, i); },
+                            [&arena] { arena.reset(); }) << " ms/tick\n";
+}
+
+// 'threads' threads repeatedly copy and drop their own copy of one shared pointer, all
+// hammering the same reference count. Returns million copy+destroy pairs per second.
+template<typename Ptr>
+double time_shared_copies(unsigned threads, const Ptr& shared, std::size_t copies_per_thread) {
+    std::atomic<long> sink{0};
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&sink, shared, copies_per_thread] {
+            long seen = 0;
+            for (std::size_t i = 0; i < copies_per_thread; ++i) {
+                Ptr copy = shared;
+                seen += *copy;
+            }
+            sink += seen;
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (sink.load() != static_cast<long>(threads * copies_per_thread)) {
+        throw std::runtime_error("Shared copy benchmark miscounted");
+    }
+    return static_cast<double>(threads * copies_per_thread) / elapsed.count() / 1e6;
+}
+
+void benchmark_shared_copies() {
+    std::cout << "\n--- Benchmark: SimpleSharedPtr vs std::shared_ptr copy/destroy under contention ---\n";
+    std::cout << "sizeof: SimpleSharedPtr " << sizeof(SimpleSharedPtr<int>) << " bytes, std::shared_ptr "
+              << sizeof(std::shared_ptr<int>) << " bytes\n";
+    constexpr std::size_t copies = 2000000;
+    const auto simple = make_simple_shared<int>(1);
+    const auto standard = std::make_shared<int>(1);
+    for (const unsigned threads : {1u, 2u, 4u, 8u}) {
+        std::cout << threads << " threads: SimpleSharedPtr " << time_shared_copies(threads, simple, copies)
+                  << " M copies/s, std::shared_ptr " << time_shared_copies(threads, standard, copies) << " M copies/s\n";
+    }
+    const auto local = make_simple_shared<int, NonAtomicCount>(1);
+    std::cout << "1 thread, NonAtomicCount: " << time_shared_copies(1, local, copies) << " M copies/s\n";
+}
+
+// Build a graph's worth of shared nodes and walk them in random order. Reports the bytes each
+// node costs (handle plus heap block) and ns per node visited.
+template<typename Make>
+void time_shared_nodes(const char* name, std::size_t heap_bytes, Make make) {
+    constexpr std::size_t nodes = 1000000;
+    std::vector<decltype(make(0))> handles;
+    handles.reserve(nodes);
+    for (std::size_t i = 0; i < nodes; ++i) {
+        handles.push_back(make(static_cast<int>(i)));
+    }
+    std::vector<std::uint32_t> order(nodes);
+    std::iota(order.begin(), order.end(), 0u);
+    std::shuffle(order.begin(), order.end(), std::mt19937(20));
+    long sum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (const std::uint32_t i : order) {
+        const auto copy = handles[i]; // Share and drop, as a graph walk would
+        sum += copy->value;
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    if (sum != static_cast<long>(nodes) * (nodes - 1) / 2) {
+        throw std::runtime_error("Shared node walk miscounted");
+    }
+    std::cout << name << ": " << sizeof(handles[0]) + heap_bytes << " bytes/node, "
+              << elapsed.count() / static_cast<double>(nodes) << " ns/node visited\n";
+}
+
+// Plain payload for the non-intrusive pointers
+struct PlainNode {
+    int value;
+};
+
+void benchmark_intrusive_nodes() {
+    std::cout << "\n--- Benchmark: 1M shared graph nodes (random-order copy + read) ---\n";
+    time_shared_nodes("IntrusivePtr<GraphNode>", sizeof(GraphNode), [](int i) { return make_intrusive<GraphNode>(i); });
+    time_shared_nodes("SimpleSharedPtr<PlainNode>", sizeof(SharedControlBlock<PlainNode, AtomicCount>),
+                      [](int i) { return make_simple_shared<PlainNode>(PlainNode{i}); });
+    time_shared_nodes("std::shared_ptr<PlainNode> (make_shared)", 16 + sizeof(PlainNode), // Vtable ptr + two 4-byte counts
+                      [](int i) { return std::make_shared<PlainNode>(PlainNode{i}); });
+}
+
+// Small polymorphic payload (40 bytes with its vptr), as in a physics step
+struct Body {
+    virtual ~Body() = default;
+    virtual double energy() const = 0;
+};
+
+struct PointMass : Body {
+    double mass, vx, vy, vz;
+    PointMass(double m, double x, double y, double z) : mass(m), vx(x), vy(y), vz(z) {}
+    double energy() const override { return 0.5 * mass * (vx * vx + vy * vy + vz * vz); }
+};
+
+// Sum energy() over the vector several times. Returns ns per element visited.
+template<typename Boxes>
+double time_iteration(const Boxes& bodies) {
+    constexpr int passes = 20;
+    double sum = 0.0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const auto& body : bodies) {
+            sum += body->energy();
+        }
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    if (sum <= 0.0) {
+        throw std::runtime_error("Unexpected energy checksum");
+    }
+    return elapsed.count() / static_cast<double>(passes * bodies.size());
+}
+
+void benchmark_sbo_iteration() {
+    std::cout << "\n--- Benchmark: iterating 1M polymorphic objects (SimpleUniquePtr vs SboBox) ---\n";
+    constexpr std::size_t count = 1000000;
+    std::vector<SimpleUniquePtr<Body>> pointers;
+    std::vector<SboBox<Body>> boxes;
+    pointers.reserve(count);
+    boxes.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const double v = static_cast<double>(i % 100);
+        pointers.emplace_back(make_simple_unique<PointMass>(1.0, v, 0.0, 0.0).release());
+        boxes.push_back(make_sbo_box<Body, PointMass>(1.0, v, 0.0, 0.0));
+    }
+    std::cout << "sizeof: SimpleUniquePtr " << sizeof(SimpleUniquePtr<Body>) << " + " << sizeof(PointMass)
+              << " on the heap, SboBox " << sizeof(SboBox<Body>) << " bytes inline\n";
+    std::cout << "SimpleUniquePtr, allocation order: " << time_iteration(pointers) << " ns/element\n";
+    std::cout << "SboBox: " << time_iteration(boxes) << " ns/element\n";
+    // Long-lived containers get reordered; the heap objects stay where they were allocated
+    std::shuffle(pointers.begin(), pointers.end(), std::mt19937(23));
+    std::shuffle(boxes.begin(), boxes.end(), std::mt19937(23));
+    std::cout << "SimpleUniquePtr, after shuffling: " << time_iteration(pointers) << " ns/element\n";
+    std::cout << "SboBox, after shuffling: " << time_iteration(boxes) << " ns/element\n";
+}
+
+void run_benchmarks() {
+    std::cout << "=== RAII Kata #2: SimpleUniquePtr Benchmarks ===\n";
+    benchmark_trace_policy();
+    benchmark_for_overwrite();
+    benchmark_pooled_allocation();
+    benchmark_arena_ticks();
+    benchmark_shared_copies();
+    benchmark_intrusive_nodes();
+    benchmark_sbo_iteration();
+    benchmark_recycler_churn();
+}
+
+int main(int argc, char* argv[]) {
+    // "--bench" runs the microbenchmarks instead of the kata tests
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        run_benchmarks();
+        return 0;
+    }
     test_move_semantics();
     return 0;
 }